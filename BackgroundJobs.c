@@ -0,0 +1,273 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "Command.h"
+#include "WorkerPool.h"
+#include "Solver.h"
+#include "BackgroundJobs.h"
+#include "mainAux.h"
+
+/*
+ * BackgroundJobRun is the argument of a job run on a worker:
+ * the jobs of the game and the job itself
+ */
+typedef struct BackgroundJobRun{
+	BackgroundJobs * jobs;
+	BackgroundJob * job;
+}BackgroundJobRun;
+
+/***** BackgroundJobs inner functions *****/
+
+/*
+ * the stop condition of the job solver (see Solver.h): returns 1 iff the job was canceled
+ */
+int isBackgroundJobCanceled(void * arg){
+	BackgroundJobRun * run = (BackgroundJobRun *) arg;
+	int canceled;
+
+	pthread_mutex_lock(&run->jobs->lock);
+	canceled = run->job->canceled;
+	pthread_mutex_unlock(&run->jobs->lock);
+	return canceled;
+}
+
+/*
+ * the stop condition of the num_solutions search: returns 1 iff the job was canceled or its time limit passed
+ */
+int isBackgroundJobStopped(void * arg){
+	BackgroundJobRun * run = (BackgroundJobRun *) arg;
+
+	return isBackgroundJobCanceled(arg) == 1 || isSolverDeadlinePassed(&run->job->deadline) == 1;
+}
+
+/*
+ * mark the job as finished with the given result and wake up the threads that wait for it
+ */
+void finishBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job, int result, int numOfSolutions){
+	pthread_mutex_lock(&jobs->lock);
+	job->result = result;
+	job->numOfSolutions = numOfSolutions;
+	job->state = JOB_FINISHED;
+	pthread_cond_broadcast(&jobs->jobFinished);
+	pthread_mutex_unlock(&jobs->lock);
+}
+
+/*
+ * run a job on a worker (the pool job function)
+ */
+void runBackgroundJob(void * arg){
+	BackgroundJobRun run = *(BackgroundJobRun *) arg;
+	BackgroundJob * job = run.job;
+	int result;
+	int numOfSolutions = 0;
+
+	free(arg);
+
+	/* a job that was canceled while it was queued isn't run */
+	pthread_mutex_lock(&run.jobs->lock);
+	if (job->canceled == 1){
+		pthread_mutex_unlock(&run.jobs->lock);
+		finishBackgroundJob(run.jobs, job, SUDOKU_STOPPED, 0);
+		return;
+	}
+	job->state = JOB_RUNNING;
+	pthread_mutex_unlock(&run.jobs->lock);
+
+	/* the time limit counts from now, not from the time the job was queued */
+	setSolverDeadline(&job->deadline, job->timeLimit);
+	if (job->type == VALIDATE){
+		result = solveBoardWithILPWithin(job->board, job->m, job->n, isBackgroundJobCanceled, &run, &job->deadline,
+				job->solution);
+	}
+	else {
+		result = cntNumSolutionsUntil(job->board, job->m, job->n, isBackgroundJobStopped, &run, &numOfSolutions);
+		if (result == SUDOKU_STOPPED && isBackgroundJobCanceled(&run) == 0){
+			result = SUDOKU_TIMEOUT;
+		}
+	}
+	finishBackgroundJob(run.jobs, job, result, numOfSolutions);
+}
+
+
+/***** BackgroundJobs.h implementation *****/
+
+BackgroundJobs * createBackgroundJobs(int numOfWorkers, WorkerPool * sharedPool){
+	BackgroundJobs * jobs;
+
+	jobs = (BackgroundJobs *) malloc(sizeof(BackgroundJobs));
+	if (jobs == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	jobs->ownsPool = sharedPool == NULL;
+	jobs->pool = sharedPool != NULL ? sharedPool : createWorkerPool(numOfWorkers);
+	if (jobs->pool == NULL){
+		free(jobs);
+		return NULL;
+	}
+	pthread_mutex_init(&jobs->lock, NULL);
+	pthread_cond_init(&jobs->jobFinished, NULL);
+	jobs->first = NULL;
+	jobs->last = NULL;
+	jobs->nextId = 1;
+	return jobs;
+}
+
+void freeBackgroundJobs(BackgroundJobs * jobs){
+	BackgroundJob * job;
+
+	if (jobs == NULL){
+		return;
+	}
+	for (job = jobs->first; job != NULL; job = job->next){
+		cancelBackgroundJob(jobs, job);
+	}
+	/* the workers finish the jobs they are running (the queued jobs were removed from the queue) */
+	if (jobs->ownsPool == 1){
+		freeWorkerPool(jobs->pool);
+	}
+	else {
+		for (job = jobs->first; job != NULL; job = job->next){
+			waitPoolJob(jobs->pool, &job->poolJob);
+		}
+	}
+	jobs->pool = NULL;
+
+	while (jobs->first != NULL){
+		job = jobs->first;
+		jobs->first = job->next;
+		freeBoardSnapshot(job->board);
+		freeBoardSnapshot(job->solution);
+		free(job);
+	}
+	pthread_mutex_destroy(&jobs->lock);
+	pthread_cond_destroy(&jobs->jobFinished);
+	free(jobs);
+}
+
+BackgroundJob * startBackgroundJob(BackgroundJobs * jobs, commandType type, int ** board, int m, int n, long boardVersion,
+		long timeLimit){
+	BackgroundJob * job;
+	BackgroundJobRun * run;
+
+	job = (BackgroundJob *) malloc(sizeof(BackgroundJob));
+	run = (BackgroundJobRun *) malloc(sizeof(BackgroundJobRun));
+	if (job == NULL || run == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	job->board = createBoardSnapshot(board, m*n);
+	job->solution = NULL;
+	if (job->board != NULL && type == VALIDATE){
+		job->solution = createBoardSnapshot(NULL, m*n);
+	}
+	if (job->board == NULL || (type == VALIDATE && job->solution == NULL)){
+		freeBoardSnapshot(job->board);
+		free(job);
+		free(run);
+		return NULL;
+	}
+	job->id = jobs->nextId++;
+	job->type = type;
+	job->m = m;
+	job->n = n;
+	job->boardVersion = boardVersion;
+	job->state = JOB_QUEUED;
+	job->canceled = 0;
+	job->result = SUDOKU_OK;
+	job->numOfSolutions = 0;
+	job->timeLimit = timeLimit;
+	setSolverDeadline(&job->deadline, timeLimit);
+	job->next = NULL;
+
+	/* only the game thread changes the list, the workers only see their own job */
+	if (jobs->last == NULL){
+		jobs->first = job;
+	}
+	else {
+		jobs->last->next = job;
+	}
+	jobs->last = job;
+
+	run->jobs = jobs;
+	run->job = job;
+	submitPoolJob(jobs->pool, &job->poolJob, runBackgroundJob, run);
+	return job;
+}
+
+BackgroundJob * findBackgroundJob(BackgroundJobs * jobs, int id){
+	BackgroundJob * job;
+
+	for (job = jobs->first; job != NULL; job = job->next){
+		if (job->id == id){
+			return job;
+		}
+	}
+	return NULL;
+}
+
+int getBackgroundJobState(BackgroundJobs * jobs, BackgroundJob * job){
+	int state;
+
+	pthread_mutex_lock(&jobs->lock);
+	state = job->state;
+	pthread_mutex_unlock(&jobs->lock);
+	return state;
+}
+
+void waitBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job){
+	pthread_mutex_lock(&jobs->lock);
+	while (job->state != JOB_FINISHED){
+		pthread_cond_wait(&jobs->jobFinished, &jobs->lock);
+	}
+	pthread_mutex_unlock(&jobs->lock);
+}
+
+void cancelBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job){
+	int removed = 0;
+
+	pthread_mutex_lock(&jobs->lock);
+	job->canceled = 1;
+	/* a queued job is finished at once, without waiting for a worker */
+	if (job->state == JOB_QUEUED && removePoolJob(jobs->pool, &job->poolJob) == 1){
+		free(job->poolJob.arg);
+		removed = 1;
+	}
+	pthread_mutex_unlock(&jobs->lock);
+	if (removed == 1){
+		finishBackgroundJob(jobs, job, SUDOKU_STOPPED, 0);
+	}
+}
+
+BackgroundJob * takeFinishedBackgroundJob(BackgroundJobs * jobs){
+	BackgroundJob * job;
+	BackgroundJob * prev = NULL;
+
+	for (job = jobs->first; job != NULL; job = job->next){
+		if (getBackgroundJobState(jobs, job) == JOB_FINISHED){
+			if (prev == NULL){
+				jobs->first = job->next;
+			}
+			else {
+				prev->next = job->next;
+			}
+			if (jobs->last == job){
+				jobs->last = prev;
+			}
+			job->next = NULL;
+			return job;
+		}
+		prev = job;
+	}
+	return NULL;
+}
+
+void freeBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job){
+	/* the worker may still be returning from the job function */
+	waitPoolJob(jobs->pool, &job->poolJob);
+	freeBoardSnapshot(job->board);
+	freeBoardSnapshot(job->solution);
+	free(job);
+}
@@ -0,0 +1,152 @@
+/************************************
+* FILES NAMES :        BackgroundJobs.c , BackgroundJobs.h
+*
+* DESCRIPTION :
+*       Background solver jobs of a game: validate and num_solutions commands that run on a worker pool
+*       against a snapshot of the board, while the game keeps reading and executing commands.
+*
+* PUBLIC FUNCTIONS :
+*       BackgroundJobs * createBackgroundJobs(int numOfWorkers, WorkerPool * sharedPool)
+*       void freeBackgroundJobs(BackgroundJobs * jobs)
+*       BackgroundJob * startBackgroundJob(BackgroundJobs * jobs, commandType type, int ** board, int m, int n, long boardVersion,
+*                                          long timeLimit)
+*       BackgroundJob * findBackgroundJob(BackgroundJobs * jobs, int id)
+*       int getBackgroundJobState(BackgroundJobs * jobs, BackgroundJob * job)
+*       void waitBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job)
+*       void cancelBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job)
+*       BackgroundJob * takeFinishedBackgroundJob(BackgroundJobs * jobs)
+*       void freeBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job)
+*
+* NOTES :
+*       1. Every job owns a snapshot of the board it was started on (see Solver.h), and remembers the board version
+*          at that time, so the game can tell whether the result still applies to its board.
+*       2. The jobs list is shared by the game thread and the workers and is protected by a single lock.
+*          Only the game thread adds jobs to the list and removes them from it.
+*       3. A validate job also keeps the solution the ILP solver found, so a result that still applies to the game board
+*          can answer later commands (see the speculative solving in Game.h).
+*       4. Canceling a running job stops its search (or terminates its ILP optimization), and its result is dropped.
+*          A queued job is removed from the pool queue, so canceled jobs never wait for a worker.
+*          A job with a time limit is stopped once it passed, like the solver commands (see SolverDeadline in Solver.h).
+*          The limit counts from the moment a worker starts the job, so the time it waited in the queue isn't charged to it.
+*       5. The jobs run on a pool of their own, or on a shared pool (the server solver pool, see Server.h),
+*          so the background jobs of all the server sessions are bounded by the server workers.
+*       6. The files that include BackgroundJobs.h must include pthread.h, Command.h, WorkerPool.h and Solver.h before it.
+*
+************************************/
+
+/* number of workers that run the background jobs of a game (without a shared pool) */
+#define BACKGROUND_JOB_WORKERS 2
+
+/*
+ * background job states:
+ * 1. JOB_QUEUED - waiting for a free worker
+ * 2. JOB_RUNNING - a worker is running the job
+ * 3. JOB_FINISHED - the job result is ready (or the job was canceled before it started)
+ */
+typedef enum jobState {
+	JOB_QUEUED, JOB_RUNNING, JOB_FINISHED} jobState;
+
+/*
+ * BackgroundJob is a single background solver job:
+ * 1. poolJob - the job in the worker pool queue
+ * 2. id - the job number, as shown to the user
+ * 3. type - VALIDATE or NUM_SOLUTIONS
+ * 4. board, m, n - the board snapshot the job works on (owned by the job) and its block dimensions
+ * 5. solution - the validate job solution of the board, valid iff result is SUDOKU_OK (NULL for num_solutions jobs)
+ * 6. boardVersion - the game board version when the job was started
+ * 7. state - the job state (jobState)
+ * 8. canceled - 1 iff the job was canceled
+ * 9. result - the solver sudokuResult (see Solver.h), SUDOKU_TIMEOUT if the time limit was reached
+ * 10. numOfSolutions - the num_solutions job result
+ * 11. timeLimit - the job time limit in milliseconds (0 for no limit)
+ * 		deadline - the job deadline, started when a worker starts the job
+ * 12. next - the next job in the jobs list
+ */
+typedef struct BackgroundJob{
+	PoolJob poolJob;
+	int id;
+	commandType type;
+	int ** board;
+	int ** solution;
+	int m;
+	int n;
+	long boardVersion;
+	int state;
+	int canceled;
+	int result;
+	int numOfSolutions;
+	long timeLimit;
+	SolverDeadline deadline;
+	struct BackgroundJob * next;
+}BackgroundJob;
+
+/*
+ * BackgroundJobs struct contains:
+ * 1. pool - the workers that run the jobs
+ * 2. ownsPool - 1 iff the pool was started for the jobs (and is freed with them), 0 for a shared pool
+ * 3. lock - protects the jobs states and canceled flags
+ * 4. jobFinished - broadcast when a job is finished
+ * 5. first, last - the jobs list, in order of their start
+ * 6. nextId - the id of the next started job
+ */
+typedef struct BackgroundJobs{
+	WorkerPool * pool;
+	int ownsPool;
+	pthread_mutex_t lock;
+	pthread_cond_t jobFinished;
+	BackgroundJob * first;
+	BackgroundJob * last;
+	int nextId;
+}BackgroundJobs;
+
+/*
+ * allocates the background jobs of a game. the jobs run on sharedPool, unless it is NULL -
+ * then they run on a pool of numOfWorkers workers of their own.
+ * returns NULL if the workers cannot be started
+ */
+BackgroundJobs * createBackgroundJobs(int numOfWorkers, WorkerPool * sharedPool);
+
+/*
+ * cancels all of the jobs, waits for the running ones to stop and frees the jobs (and the pool, if they own it)
+ */
+void freeBackgroundJobs(BackgroundJobs * jobs);
+
+/*
+ * starts a new job of the given type (VALIDATE or NUM_SOLUTIONS) on a snapshot of board,
+ * with a time limit of timeLimit milliseconds (0 for no limit), adds it to the end of the jobs list and returns it.
+ * returns NULL if the board snapshot cannot be allocated
+ */
+BackgroundJob * startBackgroundJob(BackgroundJobs * jobs, commandType type, int ** board, int m, int n, long boardVersion,
+		long timeLimit);
+
+/*
+ * returns the job with the given id, or NULL if there is no such job in the list
+ */
+BackgroundJob * findBackgroundJob(BackgroundJobs * jobs, int id);
+
+/*
+ * returns the current state of the job (jobState)
+ */
+int getBackgroundJobState(BackgroundJobs * jobs, BackgroundJob * job);
+
+/*
+ * waits until the job is finished
+ */
+void waitBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job);
+
+/*
+ * cancels the job: a job that didn't start is finished without running,
+ * and a running job solver is stopped
+ */
+void cancelBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job);
+
+/*
+ * removes the first finished job from the jobs list and returns it,
+ * or returns NULL if no job is finished. the caller frees the job with freeBackgroundJob
+ */
+BackgroundJob * takeFinishedBackgroundJob(BackgroundJobs * jobs);
+
+/*
+ * frees a job that was removed from the jobs list
+ */
+void freeBackgroundJob(BackgroundJobs * jobs, BackgroundJob * job);
@@ -0,0 +1,491 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "BoardFile.h"
+#include "mainAux.h"
+
+/***** BoardFile inner functions *****/
+
+/*
+ * return 1 iff ch is one of the DELIMITER chars
+ */
+int isTextBoardDelimiter(char ch) {
+	return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+/*
+ * refill the reader buffer from its file if all of the buffer chars were parsed.
+ * returns 1 iff there is a char to parse
+ */
+int fillTextBoardBuffer(TextBoardReader * reader) {
+	if(reader->pos < reader->len) {
+		return 1;
+	}
+	reader->len = (int) fread(reader->buffer, 1, TEXT_BOARD_BUFFER_SIZE, reader->fp);
+	reader->pos = 0;
+	return reader->len > 0;
+}
+
+/*
+ * return the size in bytes of a single cell value of an N*N binary board
+ */
+int getBinaryCellBytes(int N) {
+	if(N > BINARY_BOARD_MAX_BYTE_VALUE) {
+		return 2;
+	}
+	return 1;
+}
+
+/*
+ * return the size in bytes of the fixed cells bitmap of an N*N board
+ */
+long getBitmapSize(int N) {
+	return ((long) N*N + 7) / 8;
+}
+
+/*
+ * return the value of cell number k (row by row) in the mapped board
+ */
+int getBinaryCellValue(BinaryBoard * board, long k) {
+	if(board->cellBytes == 1) {
+		return board->cells[k];
+	}
+	return getUint16(board->cells + 2*k);
+}
+
+/*
+ * fsyncs the directory of path, so a rename in it is on disk. returns 1 on success, 0 otherwise
+ */
+int syncParentDirectory(char * path) {
+	char * dirPath;
+	char * slash;
+	int fd;
+	int success = 1;
+
+	dirPath = (char *) malloc(strlen(path) + 2);
+	if (dirPath == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	strcpy(dirPath, path);
+	slash = strrchr(dirPath, '/');
+	if(slash == NULL) {
+		strcpy(dirPath, ".");
+	}
+	else if(slash == dirPath) {
+		dirPath[1] = '\0';
+	}
+	else {
+		*slash = '\0';
+	}
+
+	fd = open(dirPath, O_RDONLY);
+	free(dirPath);
+	if(fd < 0) {
+		return 0;
+	}
+	if(fsync(fd) != 0) {
+		success = 0;
+	}
+	close(fd);
+	return success;
+}
+
+
+/***** BoardFile.h implementation *****/
+
+void initTextBoardReader(TextBoardReader * reader, FILE * fp) {
+	reader->fp = fp;
+	reader->buffer = (char *) malloc(TEXT_BOARD_BUFFER_SIZE);
+	if (reader->buffer == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	reader->pos = 0;
+	reader->len = 0;
+}
+
+int readTextBoardToken(TextBoardReader * reader, int * value, int * hasDot) {
+	char ch;
+	int numOfDigits = 0;
+	int isNumeric = 1; /* 0 once the token isn't digits optionally followed by a dot */
+
+	/* skip the delimiters before the token */
+	while(1) {
+		if(fillTextBoardBuffer(reader) == 0) {
+			return 0;
+		}
+		if(isTextBoardDelimiter(reader->buffer[reader->pos]) == 0) {
+			break;
+		}
+		reader->pos++;
+	}
+
+	/* parse the token up to the next delimiter (or the end of the file) */
+	*value = 0;
+	*hasDot = 0;
+	while(fillTextBoardBuffer(reader) == 1) {
+		ch = reader->buffer[reader->pos];
+		if(isTextBoardDelimiter(ch) == 1) {
+			break;
+		}
+		if(*hasDot == 0 && ch >= '0' && ch <= '9') {
+			/* a long digits run stays above any board value instead of overflowing */
+			*value = *value * 10 + (ch - '0');
+			if(*value > TEXT_BOARD_MAX_VALUE) {
+				*value = TEXT_BOARD_MAX_VALUE + 1;
+			}
+			numOfDigits++;
+		}
+		else if(*hasDot == 0 && ch == '.') {
+			*hasDot = 1;
+		}
+		else {
+			isNumeric = 0;
+		}
+		reader->pos++;
+	}
+	if(isNumeric == 0 || numOfDigits == 0) {
+		*value = TEXT_BOARD_BAD_VALUE;
+	}
+	return 1;
+}
+
+void freeTextBoardReader(TextBoardReader * reader) {
+	free(reader->buffer);
+	reader->buffer = NULL;
+}
+
+void putUint16(unsigned char * buf, int x) {
+	buf[0] = (unsigned char) (x & 0xFF);
+	buf[1] = (unsigned char) ((x >> 8) & 0xFF);
+}
+
+int getUint16(unsigned char * buf) {
+	return buf[0] | (buf[1] << 8);
+}
+
+void putUint32(unsigned char * buf, long x) {
+	buf[0] = (unsigned char) (x & 0xFF);
+	buf[1] = (unsigned char) ((x >> 8) & 0xFF);
+	buf[2] = (unsigned char) ((x >> 16) & 0xFF);
+	buf[3] = (unsigned char) ((x >> 24) & 0xFF);
+}
+
+int isBinaryBoardFile(FILE * fp) {
+	char magic[BINARY_BOARD_MAGIC_SIZE];
+	int isBinary;
+
+	isBinary = fread(magic, 1, BINARY_BOARD_MAGIC_SIZE, fp) == BINARY_BOARD_MAGIC_SIZE &&
+			memcmp(magic, BINARY_BOARD_MAGIC, BINARY_BOARD_MAGIC_SIZE) == 0;
+	rewind(fp);
+	return isBinary;
+}
+
+int mapBinaryBoard(FILE * fp, BinaryBoard * board) {
+	struct stat fileStat;
+	unsigned char * header;
+	long k;
+	long numOfCells;
+
+	if(fstat(fileno(fp), &fileStat) != 0 || fileStat.st_size < BINARY_BOARD_HEADER_SIZE) {
+		return 0;
+	}
+	board->mappingSize = (long) fileStat.st_size;
+	board->mapping = mmap(NULL, board->mappingSize, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	if(board->mapping == MAP_FAILED) {
+		return 0;
+	}
+
+	/* read the header (the dimensions are bounded before they are multiplied) */
+	header = (unsigned char *) board->mapping;
+	board->m = getUint16(header + 6);
+	board->n = getUint16(header + 8);
+	board->cellBytes = header[5];
+	if(header[4] != BINARY_BOARD_VERSION || board->m == 0 || board->n == 0 ||
+			board->m > BINARY_BOARD_MAX_N / board->n) {
+		unmapBinaryBoard(board);
+		return 0;
+	}
+	board->N = board->m * board->n;
+
+	/*
+	 * the header and the file size must match the board dimensions:
+	 * the file must hold the N*N cells (checked by division, so it can't overflow), then exactly the bitmap
+	 */
+	if(board->cellBytes != getBinaryCellBytes(board->N) ||
+			(board->mappingSize - BINARY_BOARD_HEADER_SIZE) / board->cellBytes / board->N < board->N) {
+		unmapBinaryBoard(board);
+		return 0;
+	}
+	numOfCells = (long) board->N * board->N;
+	if(board->mappingSize - BINARY_BOARD_HEADER_SIZE - numOfCells*board->cellBytes != getBitmapSize(board->N)) {
+		unmapBinaryBoard(board);
+		return 0;
+	}
+	board->cells = header + BINARY_BOARD_HEADER_SIZE;
+	board->fixedBitmap = board->cells + numOfCells*board->cellBytes;
+
+	/* every cell value must be in the board range */
+	for(k = 0; k < numOfCells; k++) {
+		if(getBinaryCellValue(board, k) > board->N) {
+			unmapBinaryBoard(board);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+void loadBinaryBoardCells(BinaryBoard * board, int ** gameBoard, int ** fixedBoard, int loadFixedCells) {
+	int i;
+	int j;
+	long k = 0;
+
+	for(i = 0; i < board->N; i++) {
+		for(j = 0; j < board->N; j++) {
+			gameBoard[i][j] = getBinaryCellValue(board, k);
+			if(loadFixedCells == 1 && (board->fixedBitmap[k / 8] & (1 << (k % 8))) != 0) {
+				fixedBoard[i][j] = gameBoard[i][j];
+			}
+			else {
+				fixedBoard[i][j] = 0;
+			}
+			k++;
+		}
+	}
+}
+
+void unmapBinaryBoard(BinaryBoard * board) {
+	munmap(board->mapping, board->mappingSize);
+	board->mapping = NULL;
+}
+
+char * formatBinaryBoard(int ** gameBoard, int ** fixedBoard, int m, int n, int allFilledFixed, long * len) {
+	int i;
+	int j;
+	int value;
+	long k = 0;
+	int N = m*n;
+	int cellBytes = getBinaryCellBytes(N);
+	long cellsSize = (long) N*N*cellBytes;
+	unsigned char * buf;
+	unsigned char * cells;
+	unsigned char * bitmap;
+
+	/* the whole file is built in memory and written at once */
+	*len = BINARY_BOARD_HEADER_SIZE + cellsSize + getBitmapSize(N);
+	buf = (unsigned char *) calloc(*len, 1);
+	if (buf == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+
+	memcpy(buf, BINARY_BOARD_MAGIC, BINARY_BOARD_MAGIC_SIZE);
+	buf[4] = BINARY_BOARD_VERSION;
+	buf[5] = (unsigned char) cellBytes;
+	putUint16(buf + 6, m);
+	putUint16(buf + 8, n);
+
+	cells = buf + BINARY_BOARD_HEADER_SIZE;
+	bitmap = cells + cellsSize;
+	for(i = 0; i < N; i++) {
+		for(j = 0; j < N; j++) {
+			value = abs(gameBoard[i][j]);
+			if(cellBytes == 1) {
+				cells[k] = (unsigned char) value;
+			}
+			else {
+				putUint16(cells + 2*k, value);
+			}
+			if(fixedBoard[i][j] != 0 || (allFilledFixed == 1 && value != 0)) {
+				bitmap[k / 8] |= (unsigned char) (1 << (k % 8));
+			}
+			k++;
+		}
+	}
+	return (char *) buf;
+}
+
+char * formatTextBoard(int ** gameBoard, int ** fixedBoard, int m, int n, int allFilledFixed, long * len) {
+	int i;
+	int j;
+	int value;
+	int N = m*n;
+	char * buf;
+	char * cursor;
+
+	/* every cell takes at most the digits of N, a dot and a delimiter */
+	buf = (char *) malloc(TEXT_BOARD_HEADER_MAX_SIZE +
+			(long) N*N*(formatUint(NULL, N) + 2));
+	if (buf == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+
+	/* first line - m and n */
+	cursor = buf;
+	cursor += formatUint(cursor, m);
+	*cursor++ = ' ';
+	cursor += formatUint(cursor, n);
+	*cursor++ = '\n';
+
+	/* a line for every row, fixed cells are followed by a dot */
+	for(i = 0; i < N; i++) {
+		for(j = 0; j < N; j++) {
+			value = abs(gameBoard[i][j]);
+			cursor += formatUint(cursor, value);
+			if(fixedBoard[i][j] != 0 || (allFilledFixed == 1 && value != 0)) {
+				*cursor++ = '.';
+			}
+			if(j < N-1) {
+				*cursor++ = ' ';
+			}
+		}
+		*cursor++ = '\n';
+	}
+
+	*len = cursor - buf;
+	return buf;
+}
+
+int formatUint(char * buf, int x) {
+	char digits[TEXT_BOARD_MAX_DIGITS];
+	int numOfDigits = 0;
+	int k;
+
+	/* digits are produced least significant first */
+	do {
+		digits[numOfDigits++] = (char) ('0' + x % 10);
+		x /= 10;
+	} while(x > 0);
+
+	if(buf != NULL) {
+		for(k = 0; k < numOfDigits; k++) {
+			buf[k] = digits[numOfDigits - 1 - k];
+		}
+	}
+	return numOfDigits;
+}
+
+int writeAll(int fd, unsigned char * buf, long len) {
+	ssize_t written;
+
+	while(len > 0) {
+		written = write(fd, buf, len);
+		if(written < 0) {
+			if(errno == EINTR) {
+				continue;
+			}
+			return 0;
+		}
+		buf += written;
+		len -= written;
+	}
+	return 1;
+}
+
+int replaceFileAtomically(char * path, char * data, long len) {
+	char * tempPath;
+	int fd;
+
+	fd = openTempFile(path, &tempPath);
+	if(fd < 0) {
+		return 0;
+	}
+	return commitTempFile(fd, tempPath, path, writeAll(fd, (unsigned char *) data, len));
+}
+
+int openTempFile(char * path, char ** tempPath) {
+	struct stat targetStat;
+	int fd;
+	int attempt = 0;
+
+	/* the temporary file is created next to the target, so rename doesn't cross file systems */
+	*tempPath = (char *) malloc(strlen(path) + TEMP_FILE_SUFFIX_MAX_SIZE);
+	if (*tempPath == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+
+	/* sessions of a server save concurrently in one process, so a taken name is retried with the next attempt number */
+	do {
+		sprintf(*tempPath, "%s.%ld.%d%s", path, (long) getpid(), attempt, TEMP_FILE_SUFFIX);
+		fd = open(*tempPath, O_WRONLY | O_CREAT | O_EXCL, 0666);
+		attempt++;
+	} while(fd < 0 && errno == EEXIST && attempt < TEMP_FILE_MAX_ATTEMPTS);
+	if(fd < 0) {
+		free(*tempPath);
+		return -1;
+	}
+
+	/* the replaced file keeps its permissions (a new file gets the mode of open and the umask) */
+	if(stat(path, &targetStat) == 0 && fchmod(fd, targetStat.st_mode & 07777) != 0) {
+		close(fd);
+		remove(*tempPath);
+		free(*tempPath);
+		return -1;
+	}
+	return fd;
+}
+
+int commitTempFile(int fd, char * tempPath, char * path, int success) {
+	/* the data must be on disk before the rename makes it visible */
+	if(success == 1 && fsync(fd) != 0) {
+		success = 0;
+	}
+	if(close(fd) != 0) {
+		success = 0;
+	}
+	if(success == 1 && rename(tempPath, path) != 0) {
+		success = 0;
+	}
+	if(success == 0) {
+		remove(tempPath);
+	}
+	/* and the rename must be on disk before the save is reported */
+	else if(syncParentDirectory(path) == 0) {
+		success = 0;
+	}
+
+	free(tempPath);
+	return success;
+}
+
+void formatPuzzlePackHeader(unsigned char * buf, int m, int n, long count) {
+	memcpy(buf, PUZZLE_PACK_MAGIC, 4);
+	buf[4] = PUZZLE_PACK_VERSION;
+	buf[5] = (unsigned char) getBinaryCellBytes(m*n);
+	putUint16(buf + 6, m);
+	putUint16(buf + 8, n);
+	putUint32(buf + 10, count);
+}
+
+long getPackedPuzzleSize(int N) {
+	return (long) N*N*getBinaryCellBytes(N);
+}
+
+void formatPackedPuzzle(unsigned char * buf, int ** puzzle, int N) {
+	int i;
+	int j;
+	int cellBytes = getBinaryCellBytes(N);
+
+	for(i = 0; i < N; i++) {
+		for(j = 0; j < N; j++) {
+			if(cellBytes == 1) {
+				*buf = (unsigned char) puzzle[i][j];
+			}
+			else {
+				putUint16(buf, puzzle[i][j]);
+			}
+			buf += cellBytes;
+		}
+	}
+}
@@ -0,0 +1,251 @@
+/************************************
+* FILES NAMES :        BoardFile.c , BoardFile.h
+*
+* DESCRIPTION :
+*       Board file formats:
+*       1. Text board file format - a streaming tokenizer that reads the file through one large buffer.
+*       2. Binary board file format - read (via mmap, without per-cell parsing) and write.
+*       3. Saving board files - a board is formatted (in either format) into a single memory buffer,
+*          which is written to a temporary file that atomically replaces the target file.
+*       4. Puzzle pack format - a container of many puzzles of the same dimensions (written by generate_batch).
+*       The binary format is kept next to the text board format, and board files are
+*       detected as binary by their magic.
+*
+* PUBLIC FUNCTIONS :
+*       void initTextBoardReader(TextBoardReader * reader, FILE * fp)
+*       int readTextBoardToken(TextBoardReader * reader, int * value, int * hasDot)
+*       void freeTextBoardReader(TextBoardReader * reader)
+*
+*       int isBinaryBoardFile(FILE * fp)
+*       int mapBinaryBoard(FILE * fp, BinaryBoard * board)
+*       void loadBinaryBoardCells(BinaryBoard * board, int ** gameBoard, int ** fixedBoard, int loadFixedCells)
+*       void unmapBinaryBoard(BinaryBoard * board)
+*
+*       char * formatTextBoard(int ** gameBoard, int ** fixedBoard, int m, int n, int allFilledFixed, long * len)
+*       char * formatBinaryBoard(int ** gameBoard, int ** fixedBoard, int m, int n, int allFilledFixed, long * len)
+*       int formatUint(char * buf, int x)
+*       int writeAll(int fd, unsigned char * buf, long len)
+*       int replaceFileAtomically(char * path, char * data, long len)
+*       int openTempFile(char * path, char ** tempPath)
+*       int commitTempFile(int fd, char * tempPath, char * path, int success)
+*
+*       void formatPuzzlePackHeader(unsigned char * buf, int m, int n, long count)
+*       long getPackedPuzzleSize(int N)
+*       void formatPackedPuzzle(unsigned char * buf, int ** puzzle, int N)
+*
+*       void putUint16(unsigned char * buf, int x)
+*       int getUint16(unsigned char * buf)
+*       void putUint32(unsigned char * buf, long x)
+*
+* NOTES :
+*       1. The binary board file format is as follows (all integers are little endian):
+*           a. header - "SDKB", format version (1 byte), cell size in bytes (1 byte), m (2 bytes), n (2 bytes).
+*           b. cells - N*N cell values, row by row. each value takes a single byte,
+*              or 2 bytes for boards with N > BINARY_BOARD_MAX_BYTE_VALUE. The value in empty cells is 0.
+*           c. fixed cells bitmap - ceil(N*N/8) bytes, bit k (LSB first) is set iff cell k (row by row) is fixed.
+*       2. The text tokenizer parses each token (a run of chars that aren't DELIMITER chars) in a single pass:
+*          a token is a number - digits optionally followed by a dot ('.'), whose value is clamped to
+*          TEXT_BOARD_MAX_VALUE+1. any other token (e.g. "-5" or "4a") gets TEXT_BOARD_BAD_VALUE,
+*          so the board loader rejects it like an out of range value.
+*          tokens may span buffer refills, and no memory is allocated per line or per token.
+*       3. putUint16 and getUint16 encode the little endian integers of the game binary files
+*          (the binary board format and the session journal).
+*       4. A saved board file is never seen partially written: the data is written (with a single write)
+*          and fsync'ed to a temporary file in the target directory, which is then renamed over the target.
+*          If saving fails, the previous file content is kept.
+*       5. The puzzle pack format is as follows (all integers are little endian):
+*           a. header - "SDKP", format version (1 byte), cell size in bytes (1 byte), m (2 bytes), n (2 bytes),
+*              number of puzzles (4 bytes).
+*           b. puzzles - N*N cell values of each puzzle, row by row, with the cell size of the binary board format.
+*              The value in empty cells is 0, and all the non empty cells of a puzzle are fixed.
+*          A pack is streamed to a temporary file (see openTempFile) and renamed over the target once it is complete.
+*
+************************************/
+
+/* size of the text board file read buffer */
+#define TEXT_BOARD_BUFFER_SIZE 65536
+
+/* a text token value is clamped to TEXT_BOARD_MAX_VALUE+1, above any board value */
+#define TEXT_BOARD_MAX_VALUE BINARY_BOARD_MAX_N
+
+/* the value of a text token that isn't a number (digits optionally followed by a dot) */
+#define TEXT_BOARD_BAD_VALUE -1
+
+/* binary board file format constants */
+#define BINARY_BOARD_MAGIC "SDKB"
+#define BINARY_BOARD_MAGIC_SIZE 4
+#define BINARY_BOARD_VERSION 1
+#define BINARY_BOARD_HEADER_SIZE 10
+#define BINARY_BOARD_MAX_BYTE_VALUE 255
+
+/* max board size of a binary board file (the largest value of a 2 bytes cell) */
+#define BINARY_BOARD_MAX_N 65535
+
+/* puzzle pack format constants */
+#define PUZZLE_PACK_MAGIC "SDKP"
+#define PUZZLE_PACK_VERSION 1
+#define PUZZLE_PACK_HEADER_SIZE 14
+
+/* text board file writing constants */
+#define TEXT_BOARD_HEADER_MAX_SIZE 32
+#define TEXT_BOARD_MAX_DIGITS 12
+
+/* suffix of the temporary file a saved board is written to (after the target path, the process id and the attempt number) */
+#define TEMP_FILE_SUFFIX ".tmp"
+#define TEMP_FILE_SUFFIX_MAX_SIZE 48
+#define TEMP_FILE_MAX_ATTEMPTS 64
+
+/*
+ * TextBoardReader reads a text board file token by token:
+ * 1. fp - the board file
+ * 2. buffer - the read buffer, of size TEXT_BOARD_BUFFER_SIZE
+ * 3. pos, len - the next char to parse and the number of chars in the buffer
+ */
+typedef struct TextBoardReader{
+	FILE * fp;
+	char * buffer;
+	int pos;
+	int len;
+}TextBoardReader;
+
+/*
+ * BinaryBoard describes a mapped binary board file:
+ * 1. mapping, mappingSize - the memory mapping of the whole file
+ * 2. m, n, N - the board dimensions
+ * 3. cellBytes - size of a single cell value in bytes
+ * 4. cells - pointer to the cells values in the mapping
+ * 5. fixedBitmap - pointer to the fixed cells bitmap in the mapping
+ */
+typedef struct BinaryBoard{
+	void * mapping;
+	long mappingSize;
+	int m;
+	int n;
+	int N;
+	int cellBytes;
+	unsigned char * cells;
+	unsigned char * fixedBitmap;
+}BinaryBoard;
+
+/*
+ * initialize reader to read the open text board file fp, allocating its read buffer
+ */
+void initTextBoardReader(TextBoardReader * reader, FILE * fp);
+
+/*
+ * reads the next token of the text board file.
+ * puts the token value in value, and 1 in hasDot iff the token contains a dot ('.').
+ * a token that isn't digits optionally followed by a dot gets TEXT_BOARD_BAD_VALUE.
+ * returns 1 iff a token was read (0 in the end of the file)
+ */
+int readTextBoardToken(TextBoardReader * reader, int * value, int * hasDot);
+
+/*
+ * frees the reader read buffer
+ */
+void freeTextBoardReader(TextBoardReader * reader);
+
+/*
+ * gets an open file and returns 1 iff it starts with the binary board magic.
+ * the file position is set back to the file start
+ */
+int isBinaryBoardFile(FILE * fp);
+
+/*
+ * maps the open binary board file fp to memory and fills board with the mapped header and arrays.
+ * returns 1 iff the file was mapped and its size and values match a valid binary board.
+ * NOTE: the mapping stays valid after fp is closed, until unmapBinaryBoard is called
+ */
+int mapBinaryBoard(FILE * fp, BinaryBoard * board);
+
+/*
+ * copies the mapped board cells to gameBoard.
+ * if loadFixedCells is 1 - fixed cells values are copied to fixedBoard, and all other cells are 0 in it.
+ * otherwise, all fixedBoard cells are 0.
+ */
+void loadBinaryBoardCells(BinaryBoard * board, int ** gameBoard, int ** fixedBoard, int loadFixedCells);
+
+/*
+ * unmaps a board that was mapped by mapBinaryBoard
+ */
+void unmapBinaryBoard(BinaryBoard * board);
+
+/*
+ * formats the board in the text board file format into a newly allocated buffer,
+ * puts the formatted length in len and returns the buffer (the caller frees it).
+ * a cell is fixed iff it is non zero in fixedBoard, or allFilledFixed is 1 and the cell isn't empty.
+ */
+char * formatTextBoard(int ** gameBoard, int ** fixedBoard, int m, int n, int allFilledFixed, long * len);
+
+/*
+ * formats the board in the binary board file format into a newly allocated buffer,
+ * puts the formatted length in len and returns the buffer (the caller frees it).
+ * a cell is fixed iff it is non zero in fixedBoard, or allFilledFixed is 1 and the cell isn't empty.
+ */
+char * formatBinaryBoard(int ** gameBoard, int ** fixedBoard, int m, int n, int allFilledFixed, long * len);
+
+/*
+ * writes the decimal digits of the non negative integer x to buf (without a terminating null char),
+ * and returns the number of digits. if buf is NULL only the number of digits is returned
+ */
+int formatUint(char * buf, int x);
+
+/*
+ * writes len bytes from buf to the file descriptor fd, retrying on partial writes.
+ * returns 1 iff all the bytes were written
+ */
+int writeAll(int fd, unsigned char * buf, long len);
+
+/*
+ * replaces the content of the file in the given path with len bytes of data:
+ * the data is written to a temporary file next to it, which is then renamed over path.
+ * returns 1 iff the file was replaced (otherwise, the file in path is left untouched)
+ */
+int replaceFileAtomically(char * path, char * data, long len);
+
+/*
+ * creates a new temporary file next to the file in the given path, and opens it for writing.
+ * if the file in path exists, the temporary file gets its permissions.
+ * returns the file descriptor and puts the (newly allocated) temporary file path in tempPath,
+ * or returns -1 if the file cannot be created (tempPath isn't set)
+ */
+int openTempFile(char * path, char ** tempPath);
+
+/*
+ * finishes writing a temporary file opened by openTempFile:
+ * if success is 1 - the file is fsync'ed, closed and renamed over path, and the directory of path is fsync'ed,
+ * otherwise it is closed and removed.
+ * tempPath is freed. returns 1 iff the file replaced the file in path
+ */
+int commitTempFile(int fd, char * tempPath, char * path, int success);
+
+/*
+ * writes the puzzle pack header of count puzzles of N*N boards (blocks of m rows and n columns)
+ * to buf (of size PUZZLE_PACK_HEADER_SIZE)
+ */
+void formatPuzzlePackHeader(unsigned char * buf, int m, int n, long count);
+
+/*
+ * returns the size in bytes of a single puzzle of N*N board in a puzzle pack
+ */
+long getPackedPuzzleSize(int N);
+
+/*
+ * writes the cells of the N*N puzzle to buf (of size getPackedPuzzleSize(N)) in the puzzle pack format
+ */
+void formatPackedPuzzle(unsigned char * buf, int ** puzzle, int N);
+
+/*
+ * write x to buf as 2 bytes little endian
+ */
+void putUint16(unsigned char * buf, int x);
+
+/*
+ * read 2 bytes little endian from buf
+ */
+int getUint16(unsigned char * buf);
+
+/*
+ * write x to buf as 4 bytes little endian
+ */
+void putUint32(unsigned char * buf, long x);
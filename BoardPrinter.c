@@ -0,0 +1,411 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "BoardPrinter.h"
+#include "BoardFile.h"
+#include "mainAux.h"
+
+/***** BoardPrinter inner functions *****/
+
+/*
+ * builds the separator row of a frame of cols cells wide, made of colBlocks blocks,
+ * unless the cached separator row was built for the same frame width
+ */
+void buildSeparatorRow(BoardPrinter * printer, int cols, int colBlocks) {
+	int len;
+
+	if(printer->separatorCols == cols && printer->separatorBlocks == colBlocks) {
+		return;
+	}
+
+	/* 4 chars for every cell and a pipe for every block, plus the new line char */
+	len = 4*cols + colBlocks + 1;
+	free(printer->separator);
+	printer->separator = (char *) malloc(len + 1);
+	if (printer->separator == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	memset(printer->separator, DASH[0], len);
+	printer->separator[len] = NEW_LINE[0];
+	printer->separatorLen = len + 1;
+	printer->separatorCols = cols;
+	printer->separatorBlocks = colBlocks;
+}
+
+/*
+ * sets the printer window (the board part that is rendered) of an N*N board with m*n blocks:
+ * the view rectangle extended to the blocks it touches, or the whole board if there is no view
+ */
+void setFrameWindow(BoardPrinter * printer, int N, int m, int n) {
+	if(printer->viewHeight == 0) {
+		printer->firstRow = 0;
+		printer->endRow = N;
+		printer->firstCol = 0;
+		printer->endCol = N;
+		return;
+	}
+
+	/* the view corner is kept inside the board, whatever board is loaded */
+	printer->firstRow = (printer->viewRow < N ? printer->viewRow : N-1) / m * m;
+	printer->firstCol = (printer->viewCol < N ? printer->viewCol : N-1) / n * n;
+	printer->endRow = (printer->firstRow + printer->viewHeight + m-1) / m * m;
+	printer->endCol = (printer->firstCol + printer->viewWidth + n-1) / n * n;
+	if(printer->endRow > N) {
+		printer->endRow = N;
+	}
+	if(printer->endCol > N) {
+		printer->endCol = N;
+	}
+}
+
+/*
+ * makes sure the frame buffer can hold a frame of capacity chars
+ */
+void reserveFrame(BoardPrinter * printer, long capacity) {
+	if(printer->frameCapacity >= capacity) {
+		return;
+	}
+	free(printer->frame);
+	printer->frame = (char *) malloc(capacity);
+	if (printer->frame == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	printer->frameCapacity = capacity;
+}
+
+/*
+ * writes a single cell (see printBoard in Game.h) to cursor and returns the number of chars written
+ */
+int renderCell(char * cursor, int value, int isFixed, int markErrors) {
+	int len = 0;
+	int absValue = abs(value);
+
+	/* a. space char */
+	cursor[len++] = SPACE[0];
+
+	/* b. cell value, right aligned to CELL_VALUE_WIDTH chars */
+	if(value == 0) {
+		cursor[len++] = SPACE[0];
+		cursor[len++] = SPACE[0];
+	}
+	else {
+		if(absValue < 10) {
+			cursor[len++] = SPACE[0];
+		}
+		len += formatUint(cursor + len, absValue);
+	}
+
+	/* c. fixed cell ".", erroneous cell "*" (when marking errors), or " " */
+	if(isFixed == 1) {
+		cursor[len++] = FIXED_CELL_DOT[0];
+	}
+	else if(value < 0 && markErrors == 1) {
+		cursor[len++] = ERR_VAL_ASTERISK[0];
+	}
+	else {
+		cursor[len++] = SPACE[0];
+	}
+	return len;
+}
+
+
+/*
+ * copies the null terminated string str to cursor and returns its length
+ */
+int copyString(char * cursor, char * str) {
+	int len = strlen(str);
+	memcpy(cursor, str, len);
+	return len;
+}
+
+/*
+ * writes the ANSI sequence that moves the terminal cursor to <line,col> (1-based) to cursor,
+ * and returns the number of chars written
+ */
+int formatCursorMove(char * cursor, int line, int col) {
+	int len = 0;
+
+	len += copyString(cursor, ANSI_CSI);
+	len += formatUint(cursor + len, line);
+	cursor[len++] = ';';
+	len += formatUint(cursor + len, col);
+	cursor[len++] = 'H';
+	return len;
+}
+
+/*
+ * returns the state of a rendered cell, packed into one int:
+ * the absolute value, whether the cell is fixed and whether it is marked as erroneous.
+ * two cells are printed the same iff their states are equal
+ */
+int getCellState(int value, int isFixed, int markErrors) {
+	int state = abs(value) * 4;
+
+	if(isFixed == 1) {
+		state += 2;
+	}
+	else if(value < 0 && markErrors == 1) {
+		state += 1;
+	}
+	return state;
+}
+
+/*
+ * returns the number of chars of a printed cell with the given state
+ */
+int getCellStateWidth(int state) {
+	int valueWidth = formatUint(NULL, state / 4);
+
+	if(valueWidth < CELL_VALUE_WIDTH) {
+		valueWidth = CELL_VALUE_WIDTH;
+	}
+	return valueWidth + 2;
+}
+
+/*
+ * writes the frame of the printer window to cursor and returns a pointer past its end.
+ * in tty mode, the state of every rendered cell is kept for the next differential rendering
+ */
+char * renderFullFrame(BoardPrinter * printer, char * cursor, int ** gameBoard, int ** fixedBoard,
+		int m, int n, int markErrors) {
+	int i;
+	int j;
+	int * cellState = printer->lastCells;
+
+	for(i = printer->firstRow; i < printer->endRow; i++) {
+		/* separator row at the beginning of each block (the window starts with a block) */
+		if(i % m == 0) {
+			memcpy(cursor, printer->separator, printer->separatorLen);
+			cursor += printer->separatorLen;
+		}
+		for(j = printer->firstCol; j < printer->endCol; j++) {
+			/* "|" at the beginning of each block row */
+			if(j % n == 0) {
+				*cursor++ = PIPE[0];
+			}
+			cursor += renderCell(cursor, gameBoard[i][j], fixedBoard[i][j] != 0, markErrors);
+			if(printer->ttyMode == 1) {
+				*cellState++ = getCellState(gameBoard[i][j], fixedBoard[i][j] != 0, markErrors);
+			}
+		}
+		/* end of row */
+		*cursor++ = PIPE[0];
+		*cursor++ = NEW_LINE[0];
+	}
+
+	/* end of board separator row */
+	memcpy(cursor, printer->separator, printer->separatorLen);
+	cursor += printer->separatorLen;
+	return cursor;
+}
+
+/*
+ * writes to cursor the ANSI sequences that update only the cells whose state changed since the last frame
+ * (the terminal cursor is saved before and restored after the update), and returns a pointer past their end.
+ * if a changed cell width differs from its printed width, the rest of its row is printed again.
+ */
+char * renderFrameDiff(BoardPrinter * printer, char * cursor, int ** gameBoard, int ** fixedBoard,
+		int m, int n, int markErrors) {
+	int i;
+	int j;
+	int k;
+	int line;
+	int col;
+	int state;
+	int width;
+	int * rowCells;
+
+	cursor += copyString(cursor, ANSI_SAVE_CURSOR);
+	rowCells = printer->lastCells;
+	for(i = printer->firstRow; i < printer->endRow; i++) {
+		/* the frame starts with a separator row, and a separator row follows each block */
+		line = (i - printer->firstRow) + (i - printer->firstRow)/m + 2;
+		col = 1;
+		for(j = printer->firstCol; j < printer->endCol; j++) {
+			if(j % n == 0) {
+				col++;
+			}
+			state = getCellState(gameBoard[i][j], fixedBoard[i][j] != 0, markErrors);
+			width = getCellStateWidth(state);
+			if(state != rowCells[j - printer->firstCol]) {
+				cursor += formatCursorMove(cursor, line, col);
+				if(width == getCellStateWidth(rowCells[j - printer->firstCol])) {
+					cursor += renderCell(cursor, gameBoard[i][j], fixedBoard[i][j] != 0, markErrors);
+					rowCells[j - printer->firstCol] = state;
+				}
+				else {
+					/* the rest of the row moved - print it again and erase what is left of the old row */
+					for(k = j; k < printer->endCol; k++) {
+						if(k % n == 0 && k != j) {
+							*cursor++ = PIPE[0];
+						}
+						cursor += renderCell(cursor, gameBoard[i][k], fixedBoard[i][k] != 0, markErrors);
+						rowCells[k - printer->firstCol] =
+								getCellState(gameBoard[i][k], fixedBoard[i][k] != 0, markErrors);
+					}
+					*cursor++ = PIPE[0];
+					cursor += copyString(cursor, ANSI_ERASE_LINE);
+					break;
+				}
+			}
+			col += width;
+		}
+		rowCells += printer->endCol - printer->firstCol;
+	}
+	cursor += copyString(cursor, ANSI_RESTORE_CURSOR);
+	return cursor;
+}
+
+
+/*
+ * forgets the cells on the terminal screen, so the next tty mode frame is printed in full
+ */
+void resetTtyState(BoardPrinter * printer) {
+	free(printer->lastCells);
+	printer->lastCells = NULL;
+	printer->lastN = 0;
+	printer->lastM = 0;
+}
+
+
+/***** BoardPrinter.h implementation *****/
+
+BoardPrinter * createBoardPrinter() {
+	BoardPrinter * printer;
+
+	printer = (BoardPrinter *) malloc(sizeof(BoardPrinter));
+	if (printer == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	printer->frame = NULL;
+	printer->frameLen = 0;
+	printer->frameCapacity = 0;
+	printer->separator = NULL;
+	printer->separatorLen = 0;
+	printer->separatorCols = 0;
+	printer->separatorBlocks = 0;
+	printer->viewRow = 0;
+	printer->viewCol = 0;
+	printer->viewHeight = 0;
+	printer->viewWidth = 0;
+	printer->firstRow = 0;
+	printer->endRow = 0;
+	printer->firstCol = 0;
+	printer->endCol = 0;
+	printer->ttyMode = 0;
+	printer->lastCells = NULL;
+	printer->lastN = 0;
+	printer->lastM = 0;
+	return printer;
+}
+
+void freeBoardPrinter(BoardPrinter * printer) {
+	if(printer == NULL) {
+		return;
+	}
+	setBoardPrinterTtyMode(printer, 0);
+	free(printer->frame);
+	free(printer->separator);
+	free(printer->lastCells);
+	free(printer);
+}
+
+void renderBoard(BoardPrinter * printer, int ** gameBoard, int ** fixedBoard, int m, int n, int markErrors) {
+	int N = m*n;
+	int rows;
+	int cols;
+	int cellWidth;
+	long rowLen;
+	long capacity;
+	int frameLines;
+	char * cursor;
+
+	setFrameWindow(printer, N, m, n);
+	rows = printer->endRow - printer->firstRow;
+	cols = printer->endCol - printer->firstCol;
+	buildSeparatorRow(printer, cols, cols / n);
+
+	/* a cell takes a space, the value and its mark (values may be wider than CELL_VALUE_WIDTH) */
+	cellWidth = formatUint(NULL, N);
+	if(cellWidth < CELL_VALUE_WIDTH) {
+		cellWidth = CELL_VALUE_WIDTH;
+	}
+	cellWidth += 2;
+	rowLen = (long) cols*cellWidth + cols/n + 2;
+	frameLines = rows + rows/m + 1;
+	capacity = rows*rowLen + (long) (rows/m + 1)*printer->separatorLen;
+
+	if(printer->ttyMode == 0) {
+		reserveFrame(printer, capacity);
+		cursor = renderFullFrame(printer, printer->frame, gameBoard, fixedBoard, m, n, markErrors);
+		printer->frameLen = cursor - printer->frame;
+		return;
+	}
+
+	/* in tty mode every cell may be preceded by a cursor move, and each row may be printed again */
+	reserveFrame(printer, capacity + (long) rows*cols*ANSI_CURSOR_MOVE_MAX_SIZE +
+			rows*(rowLen + ANSI_CURSOR_MOVE_MAX_SIZE) + ANSI_FRAME_EXTRA_SIZE);
+	if(printer->lastN == N && printer->lastM == m) {
+		cursor = renderFrameDiff(printer, printer->frame, gameBoard, fixedBoard, m, n, markErrors);
+		printer->frameLen = cursor - printer->frame;
+		return;
+	}
+
+	/* first frame of these dimensions - the screen is cleared and the board is printed at its top,
+	 * then the lines below the board are made a scroll region for the rest of the output */
+	free(printer->lastCells);
+	printer->lastCells = (int *) malloc((long) rows*cols*sizeof(int));
+	if (printer->lastCells == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	printer->lastN = N;
+	printer->lastM = m;
+
+	cursor = printer->frame;
+	cursor += copyString(cursor, ANSI_RESET_SCROLL_REGION);
+	cursor += copyString(cursor, ANSI_CLEAR_SCREEN);
+	cursor = renderFullFrame(printer, cursor, gameBoard, fixedBoard, m, n, markErrors);
+	cursor += copyString(cursor, ANSI_CSI);
+	cursor += formatUint(cursor, frameLines + 1);
+	cursor += copyString(cursor, ";r");
+	cursor += formatCursorMove(cursor, frameLines + 1, 1);
+	printer->frameLen = cursor - printer->frame;
+}
+
+int setBoardPrinterTtyMode(BoardPrinter * printer, int ttyMode) {
+	if(ttyMode == 1 && isatty(fileno(getOutput())) == 0) {
+		return 0;
+	}
+	if(ttyMode == 0 && printer->ttyMode == 1) {
+		/* give the whole screen back to the scrolling output (resetting the region moves the cursor) */
+		fputs(ANSI_SAVE_CURSOR ANSI_RESET_SCROLL_REGION ANSI_RESTORE_CURSOR, getOutput());
+	}
+	printer->ttyMode = ttyMode;
+	resetTtyState(printer);
+	return 1;
+}
+
+void setBoardPrinterView(BoardPrinter * printer, int row, int col, int height, int width) {
+	printer->viewRow = row;
+	printer->viewCol = col;
+	printer->viewHeight = height;
+	printer->viewWidth = width;
+	/* in tty mode, the next frame of the new window is printed in full */
+	resetTtyState(printer);
+}
+
+int isBoardWindowed(BoardPrinter * printer, int N) {
+	return printer->firstRow != 0 || printer->firstCol != 0 ||
+			printer->endRow != N || printer->endCol != N;
+}
+
+void printBoardFrame(BoardPrinter * printer) {
+	fwrite(printer->frame, 1, printer->frameLen, getOutput());
+}
@@ -0,0 +1,128 @@
+/************************************
+* FILES NAMES :        BoardPrinter.c , BoardPrinter.h
+*
+* DESCRIPTION :
+*       Board printing - the whole board frame is rendered into one reusable memory buffer,
+*       which is printed with a single write.
+*       In the optional tty mode, only the cells that changed since the last printed frame are sent to the terminal.
+*       An optional view limits the frame to a block aligned window of the board.
+*
+* PUBLIC FUNCTIONS :
+*       BoardPrinter * createBoardPrinter()
+*       void freeBoardPrinter(BoardPrinter * printer)
+*       void renderBoard(BoardPrinter * printer, int ** gameBoard, int ** fixedBoard, int m, int n, int markErrors)
+*       int setBoardPrinterTtyMode(BoardPrinter * printer, int ttyMode)
+*       void setBoardPrinterView(BoardPrinter * printer, int row, int col, int height, int width)
+*       int isBoardWindowed(BoardPrinter * printer, int N)
+*       void printBoardFrame(BoardPrinter * printer)
+*
+* NOTES :
+*       1. The frame format is the one described in printBoard (Game.h).
+*       2. The separator row depends only on the frame width (cells and blocks), so it is built once
+*          and kept until a frame of another width is rendered.
+*       3. The frame buffer only grows, so rendering boards of the same dimensions allocates no memory.
+*       4. tty mode (only available when the output is a terminal):
+*           a. the first frame of a board is printed at the top of a cleared screen, and the lines below it
+*              are made the terminal scroll region, so the rest of the output scrolls without moving the board.
+*           b. the printer keeps the state of every printed cell (value, fixed, erroneous mark).
+*              following frames of a board of the same dimensions only move the terminal cursor to the changed cells
+*              and print them (if a changed cell is wider or narrower than before, the rest of its row is printed).
+*           c. the board (or its window) must fit in the terminal height.
+*       5. View - the window is the view rectangle, extended to whole blocks and cut at the board end.
+*          only the window cells are visited, so the rendering cost depends on the window size and not on N*N.
+*       6. Frames are printed to the output of the calling thread output context (see mainAux.h).
+*
+************************************/
+
+/* the minimal number of chars of a cell value in a cell (printf format "%2d") */
+#define CELL_VALUE_WIDTH 2
+
+/* ANSI terminal sequences used by tty mode */
+#define ANSI_CSI "\033["
+#define ANSI_CLEAR_SCREEN "\033[H\033[2J"
+#define ANSI_RESET_SCROLL_REGION "\033[r"
+#define ANSI_ERASE_LINE "\033[K"
+#define ANSI_SAVE_CURSOR "\0337"
+#define ANSI_RESTORE_CURSOR "\0338"
+
+/* max size of a cursor move sequence, and of the other sequences added to a tty mode frame */
+#define ANSI_CURSOR_MOVE_MAX_SIZE 32
+#define ANSI_FRAME_EXTRA_SIZE 64
+
+/*
+ * BoardPrinter holds the rendering buffers:
+ * 1. frame, frameLen, frameCapacity - the rendered board frame, its length and its allocated size
+ * 2. separator, separatorLen - the cached separator row (including the new line char)
+ * 3. separatorCols, separatorBlocks - the frame width (cells and blocks) the separator row was built for
+ *    (0 if it wasn't built)
+ * 4. viewRow, viewCol, viewHeight, viewWidth - the view rectangle (0-based top left cell and size),
+ *    viewHeight is 0 if there is no view (the whole board is rendered)
+ * 5. firstRow, endRow, firstCol, endCol - the window of the last rendered frame (end indexes are exclusive)
+ * 6. ttyMode - 1 iff only the changed cells are printed (differential rendering), 0 for scrolling output
+ * 7. lastCells - in tty mode, the state of every window cell on the terminal screen (row by row)
+ * 8. lastN, lastM - the board dimensions of lastCells (0 if no frame was printed in tty mode yet)
+ */
+typedef struct BoardPrinter{
+	char * frame;
+	long frameLen;
+	long frameCapacity;
+
+	char * separator;
+	int separatorLen;
+	int separatorCols;
+	int separatorBlocks;
+
+	int viewRow;
+	int viewCol;
+	int viewHeight;
+	int viewWidth;
+	int firstRow;
+	int endRow;
+	int firstCol;
+	int endCol;
+
+	int ttyMode;
+	int * lastCells;
+	int lastN;
+	int lastM;
+}BoardPrinter;
+
+/*
+ * allocates a new board printer with empty buffers and returns a pointer to it
+ */
+BoardPrinter * createBoardPrinter();
+
+/*
+ * frees the board printer and its buffers (in tty mode, the terminal scroll region is restored first).
+ * if printer is NULL the function doesn't perform any operation
+ */
+void freeBoardPrinter(BoardPrinter * printer);
+
+/*
+ * renders the board window into the printer frame buffer (in tty mode - only the changes since the last frame).
+ * gets the board values (negative values are erroneous), the fixed cells (non zero in fixedBoard),
+ * the block dimensions m (rows) and n (cols), and markErrors - 1 iff erroneous cells are marked with an asterisk
+ */
+void renderBoard(BoardPrinter * printer, int ** gameBoard, int ** fixedBoard, int m, int n, int markErrors);
+
+/*
+ * turns tty mode on (ttyMode = 1) or off (ttyMode = 0). the next frame is rendered in full.
+ * returns 0 (and tty mode isn't turned on) if ttyMode is 1 and the output isn't a terminal, otherwise 1
+ */
+int setBoardPrinterTtyMode(BoardPrinter * printer, int ttyMode);
+
+/*
+ * sets the view to the rectangle of height rows and width cols, whose top left cell is <row,col> (0-based).
+ * a height of 0 removes the view, so the whole board is rendered
+ */
+void setBoardPrinterView(BoardPrinter * printer, int row, int col, int height, int width);
+
+/*
+ * returns 1 iff the last rendered frame of the N*N board is only a part of the board
+ */
+int isBoardWindowed(BoardPrinter * printer, int N);
+
+/*
+ * prints the last rendered frame to the output (see mainAux.h) with a single write
+ */
+void printBoardFrame(BoardPrinter * printer);
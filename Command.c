@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 200112L
+
 
 #include <stdio.h>
 #include <string.h>
@@ -57,6 +59,39 @@ commandType getCurrCommandType (char * commandTypeStr){
 	if (strcmp(commandTypeStr, EXIT_STR) == 0){
 		return EXIT;
 	}
+	if (strcmp(commandTypeStr, JOURNAL_STR) == 0){
+		return JOURNAL;
+	}
+	if (strcmp(commandTypeStr, RECOVER_STR) == 0){
+		return RECOVER;
+	}
+	if (strcmp(commandTypeStr, TTY_RENDER_STR) == 0){
+		return TTY_RENDER;
+	}
+	if (strcmp(commandTypeStr, VIEW_STR) == 0){
+		return VIEW;
+	}
+	if (strcmp(commandTypeStr, JOBS_STR) == 0){
+		return JOBS;
+	}
+	if (strcmp(commandTypeStr, WAIT_STR) == 0){
+		return WAIT;
+	}
+	if (strcmp(commandTypeStr, CANCEL_STR) == 0){
+		return CANCEL;
+	}
+	if (strcmp(commandTypeStr, PORTFOLIO_STR) == 0){
+		return PORTFOLIO;
+	}
+	if (strcmp(commandTypeStr, GENERATE_BATCH_STR) == 0){
+		return GENERATE_BATCH;
+	}
+	if (strcmp(commandTypeStr, TIME_LIMIT_STR) == 0){
+		return TIME_LIMIT;
+	}
+	if (strcmp(commandTypeStr, LOGIC_SOLVE_STR) == 0){
+		return LOGIC_SOLVE;
+	}
 	return INVALID;
 }
 
@@ -77,7 +112,7 @@ int isLegalInt(char * str) {
 
 /*
  * input:
- * 1. commandArray - the command String after we broke it to a series of tokens
+ * 1. savePtr - the strtok_r position in the command String, after the tokens that were already read
  * 2. parsedCommand - the Command struct in order to fill in the desired int params
  *
  * the function parse only the desired arguments for each command Type.
@@ -85,24 +120,28 @@ int isLegalInt(char * str) {
  * 			we change the command type to INVALID
  * b. if the argument is not an int - we change its value to -1
  */
-void extractCommandArgs (char * commandArray, Command * parsedCommand){
+void extractCommandArgs (char ** savePtr, Command * parsedCommand){
 
+	char * commandArray;
 	char * tempArg;
 
 	/*
 	 * get the first param and save it as the first element of intArgs array
 	 * if the user didn't supply such param - change command type to INVALID
 	 */
-	commandArray = strtok(NULL, DELIMITER);
+	commandArray = strtok_r(NULL, DELIMITER, savePtr);
 	if (commandArray != NULL){
 		tempArg =  commandArray;
 		if (isLegalInt(tempArg) == 1){
 			parsedCommand->intArgs[0] = atoi(tempArg);
 		}
+		else if (parsedCommand->type == GENERATE && strcmp(tempArg, AUTO_ARG_STR) == 0){
+			parsedCommand->intArgs[0] = AUTO_INT_ARG;
+		}
 		else {
 			parsedCommand->intArgs[0] = -1;
 		}
-		commandArray = strtok(NULL, DELIMITER);
+		commandArray = strtok_r(NULL, DELIMITER, savePtr);
 	}
 	else {
 		parsedCommand->type = INVALID;
@@ -112,9 +151,11 @@ void extractCommandArgs (char * commandArray, Command * parsedCommand){
 	/*
 	 * get the second param and save it as the second element of intArgs array
 	 * if the user didn't supply such param - change command type to INVALID
-	 * irrelevant for Mark_Errors (only 1 param is needed)
+	 * irrelevant for Mark_Errors, Tty_Render, Cancel, Portfolio and Time_Limit (only 1 param is needed)
 	 */
-	if (parsedCommand->type != MARK_ERRORS){
+	if (parsedCommand->type != MARK_ERRORS && parsedCommand->type != TTY_RENDER &&
+			parsedCommand->type != CANCEL && parsedCommand->type != PORTFOLIO &&
+			parsedCommand->type != TIME_LIMIT){
 		if (commandArray != NULL){
 			tempArg =  commandArray;
 			if (isLegalInt(tempArg) == 1){
@@ -123,7 +164,7 @@ void extractCommandArgs (char * commandArray, Command * parsedCommand){
 			else {
 				parsedCommand->intArgs[1] = -1;
 			}
-			commandArray = strtok(NULL, DELIMITER);
+			commandArray = strtok_r(NULL, DELIMITER, savePtr);
 		}
 		else {
 			parsedCommand->type = INVALID;
@@ -134,9 +175,9 @@ void extractCommandArgs (char * commandArray, Command * parsedCommand){
 	/*
 	 * get the third param and save it as the second element of intArgs array
 	 * if the user didn't supply such param - change command type to INVALID
-	 * relevant only for SET command (3 params are needed)
+	 * relevant only for SET and GENERATE_BATCH commands (3 params are needed)
 	 */
-	if (parsedCommand->type == SET){
+	if (parsedCommand->type == SET || parsedCommand->type == GENERATE_BATCH){
 		if (commandArray != NULL){
 			tempArg =  commandArray;
 			if (isLegalInt(tempArg) == 1){
@@ -155,15 +196,89 @@ void extractCommandArgs (char * commandArray, Command * parsedCommand){
 }
 
 /*
- * 1. commandArray - the command String after we broke it to a series of tokens
+ * 1. savePtr - the strtok_r position in the command String, after the tokens that were already read
+ * 2. parsedCommand - the Command struct in order to fill in the view int params
+ *
+ * view takes either no params, or exactly 4 params (R C H W).
+ * a. if no params were supplied - all of the int args are MISSING_INT_ARG
+ * b. if some of the params are missing - we change the command type to INVALID
+ * c. if an argument is not an int - we change its value to -1
+ */
+void extractViewArgs (char ** savePtr, Command * parsedCommand){
+	char * commandArray;
+	int k;
+
+	for (k = 0; k < 4; k++){
+		commandArray = strtok_r(NULL, DELIMITER, savePtr);
+		if (commandArray == NULL){
+			if (k != 0){
+				parsedCommand->type = INVALID;
+				return;
+			}
+			for (k = 0; k < 4; k++){
+				parsedCommand->intArgs[k] = MISSING_INT_ARG;
+			}
+			return;
+		}
+		if (isLegalInt(commandArray) == 1){
+			parsedCommand->intArgs[k] = atoi(commandArray);
+		}
+		else {
+			parsedCommand->intArgs[k] = -1;
+		}
+	}
+}
+
+/*
+ * 1. savePtr - the strtok_r position in the command String, after the tokens that were already read
+ * 2. parsedCommand - the Command struct in order to fill in the wait int param
+ *
+ * wait takes an optional job number.
+ * a. if it wasn't supplied - the int arg is MISSING_INT_ARG
+ * b. if the argument is not an int - we change its value to -1
+ */
+void extractOptionalIntArg (char ** savePtr, Command * parsedCommand){
+	char * commandArray;
+
+	commandArray = strtok_r(NULL, DELIMITER, savePtr);
+	if (commandArray == NULL){
+		parsedCommand->intArgs[0] = MISSING_INT_ARG;
+	}
+	else if (isLegalInt(commandArray) == 1){
+		parsedCommand->intArgs[0] = atoi(commandArray);
+	}
+	else {
+		parsedCommand->intArgs[0] = -1;
+	}
+}
+
+/*
+ * 1. savePtr - the strtok_r position in the command String, after the tokens that were already read
+ * 2. parsedCommand - the Command struct in order to fill in the background flag
+ *
+ * the 0 int arg is set to 1 iff the next param is the background flag, otherwise to 0
+ */
+void extractBackgroundFlag (char ** savePtr, Command * parsedCommand){
+	char * commandArray;
+
+	commandArray = strtok_r(NULL, DELIMITER, savePtr);
+	parsedCommand->intArgs[0] = (commandArray != NULL &&
+			strcmp(commandArray, BACKGROUND_FLAG_STR) == 0);
+}
+
+/*
+ * 1. savePtr - the strtok_r position in the command String, after the tokens that were already read
  * 2. parsedCommand - the Command struct in order to fill in the desired filePath param
  *
- * the function gets the filepath as supplied by the user.
- * if no filePath was supplied and the command is Save or Solve -
+ * the function gets the filepath as supplied by the user
+ * (and for save - whether the binary format flag follows it).
+ * if no filePath was supplied and the command is Save, Solve, Recover or Generate_batch -
  * 		a desired info is missing so we change the command type to INVALID
  */
-void extractCommandFilePath(char * commandArray, Command * parsedCommand){
-	commandArray = strtok(NULL, DELIMITER);
+void extractCommandFilePath(char ** savePtr, Command * parsedCommand){
+	char * commandArray;
+
+	commandArray = strtok_r(NULL, DELIMITER, savePtr);
 	/* if a file path was supplied - allocate memory for it and update command->filePath */
 	if (commandArray != NULL){
 		parsedCommand->filePath = (char*) malloc(strlen(commandArray)+1);
@@ -172,14 +287,21 @@ void extractCommandFilePath(char * commandArray, Command * parsedCommand){
 			exit(0);
 		}
 		strcpy(parsedCommand->filePath, commandArray);
+
+		/* save may be followed by the binary format flag */
+		if (parsedCommand->type == SAVE){
+			commandArray = strtok_r(NULL, DELIMITER, savePtr);
+			parsedCommand->intArgs[0] = (commandArray != NULL &&
+					strcmp(commandArray, BINARY_FORMAT_FLAG_STR) == 0);
+		}
 	}
 
 	else {
-		/* if the command type is not EDIT - the command is not valid
+		/* if the command type is not EDIT or JOURNAL - the command is not valid
 		 * because a desired information (filePath) is missing
 		 */
 		parsedCommand->filePath = NULL;
-		if (parsedCommand->type != EDIT){
+		if (parsedCommand->type != EDIT && parsedCommand->type != JOURNAL){
 			parsedCommand->type = INVALID;
 		}
 	}
@@ -201,9 +323,11 @@ Command parseCommand(char * stringOfCommand){
 	char * commandArr;
 	/* tmp string to hold command type string before converting it to the enum values */
 	char * commandTypeStr;
+	/* strtok_r position in the command string (commands may be parsed by several threads) */
+	char * savePtr;
 
     /*split the command line to string array*/
-	commandArr = strtok(stringOfCommand, DELIMITER);
+	commandArr = strtok_r(stringOfCommand, DELIMITER, &savePtr);
 
 	/*
 	 * Ignore blank lines
@@ -226,23 +350,47 @@ Command parseCommand(char * stringOfCommand){
 
 	/*
 	 * extract desired int args for the following commands :
-	 * mark_errors x, set x y z, hint x y, generate x y
+	 * mark_errors x, set x y z, hint x y, generate x y, tty_render x, cancel x, portfolio x,
+	 * generate_batch count x y, time_limit x
 	 */
 	if (parsedCommand.type == MARK_ERRORS ||
+			parsedCommand.type == TTY_RENDER ||
+			parsedCommand.type == PORTFOLIO ||
+			parsedCommand.type == TIME_LIMIT ||
+			parsedCommand.type == CANCEL ||
 			parsedCommand.type == SET ||
 			parsedCommand.type == HINT ||
-			parsedCommand.type == GENERATE){
-				extractCommandArgs(commandArr, &parsedCommand);
+			parsedCommand.type == GENERATE ||
+			parsedCommand.type == GENERATE_BATCH){
+				extractCommandArgs(&savePtr, &parsedCommand);
+	}
+
+	/* extract the optional job number of wait x */
+	if (parsedCommand.type == WAIT){
+		extractOptionalIntArg(&savePtr, &parsedCommand);
+	}
+
+	/* extract the optional background flag of validate and num_solutions */
+	if (parsedCommand.type == VALIDATE || parsedCommand.type == NUM_SOLUTIONS){
+		extractBackgroundFlag(&savePtr, &parsedCommand);
+	}
+
+	/* extract the optional int args of view r c h w */
+	if (parsedCommand.type == VIEW){
+		extractViewArgs(&savePtr, &parsedCommand);
 	}
 
 	/*
 	 * extract File path for the following commands :
-	 * solve, save , edit (File path is optional)
+	 * solve, save , recover, generate_batch (after its int args), edit and journal (File path is optional)
 	 */
 	if (parsedCommand.type == SOLVE ||
 			parsedCommand.type == EDIT ||
-			parsedCommand.type == SAVE){
-				extractCommandFilePath(commandArr, &parsedCommand);
+			parsedCommand.type == SAVE ||
+			parsedCommand.type == JOURNAL ||
+			parsedCommand.type == RECOVER ||
+			parsedCommand.type == GENERATE_BATCH){
+				extractCommandFilePath(&savePtr, &parsedCommand);
 	}
 
 	return parsedCommand;
@@ -43,6 +43,30 @@
 #define AUTOFILL_STR "autofill"
 #define RESET_STR "reset"
 #define EXIT_STR "exit"
+#define JOURNAL_STR "journal"
+#define RECOVER_STR "recover"
+#define TTY_RENDER_STR "tty_render"
+#define VIEW_STR "view"
+#define JOBS_STR "jobs"
+#define WAIT_STR "wait"
+#define CANCEL_STR "cancel"
+#define PORTFOLIO_STR "portfolio"
+#define GENERATE_BATCH_STR "generate_batch"
+#define TIME_LIMIT_STR "time_limit"
+#define LOGIC_SOLVE_STR "logic_solve"
+
+/* the value of an optional int argument that wasn't supplied */
+#define MISSING_INT_ARG -2
+
+/* generate X argument that lets the game choose X, and its int argument value */
+#define AUTO_ARG_STR "auto"
+#define AUTO_INT_ARG -3
+
+/* save optional flag for saving in the binary board file format */
+#define BINARY_FORMAT_FLAG_STR "-b"
+
+/* validate and num_solutions optional flag for running them in the background */
+#define BACKGROUND_FLAG_STR "&"
 
 /*
  * enum for all the legal commandType as described in the project info
@@ -52,14 +76,14 @@
 
 typedef enum commandType {SOLVE, EDIT, MARK_ERRORS, PRINT_BOARD, SET, VALIDATE,
 	GENERATE, UNDO, REDO, SAVE, HINT, NUM_SOLUTIONS, AUTOFILL,
-	RESET, EXIT, INVALID, IGNORE} commandType;
+	RESET, EXIT, JOURNAL, RECOVER, TTY_RENDER, VIEW, JOBS, WAIT, CANCEL, PORTFOLIO, GENERATE_BATCH, TIME_LIMIT, LOGIC_SOLVE, INVALID, IGNORE} commandType;
 
 /*
  * Command struct will help us to keep track of the user commands.
  * each Command instance has:
  * 1. type: commandType - the request command
  * 2. intArgs: command (int) args supplied by user
- * 3. filePath : file path supplied by the user for EDIT, SAVE and SOLVE
+ * 3. filePath : file path supplied by the user for EDIT, SAVE, SOLVE, JOURNAL and RECOVER
  *
  */
 typedef struct Command {
@@ -72,12 +96,21 @@ typedef struct Command {
      * intArgs has the arguments for the command that are integers
      * for example: in set <x,y,z> x will be in the 0 element place
      * y will be in the 1 element place and z will be int the 2 element place of the array
+     * (and in generate_batch <count,x,y> in the same way)
+     * in generate, the 0 element is AUTO_INT_ARG if X is "auto"
+     * in save, the 0 element is 1 iff the binary format flag was supplied
+     * in view, all four elements are MISSING_INT_ARG if no arguments were supplied
+     * in validate and num_solutions, the 0 element is 1 iff the background flag was supplied
+     * in wait, the 0 element is MISSING_INT_ARG if no job number was supplied
      * */
-    int intArgs[3];
+    int intArgs[4];
 
     /*
      * used for the commands EDIT and SOLVE to load a file from this location
      * used for the command SAVE to save the file to this location
+     * used for the command JOURNAL to write the session journal to this location
+     * used for the command RECOVER to replay the session journal from this location
+     * used for the command GENERATE_BATCH to write the puzzle pack to this location
      * */
     char * filePath;
 
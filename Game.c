@@ -2,9 +2,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include "mainAux.h"
 #include "Game.h"
+#include "WorkerPool.h"
 #include "Solver.h"
+#include "BackgroundJobs.h"
+#include "Portfolio.h"
+#include "LogicSolver.h"
+#include "PuzzleGenerator.h"
+#include "PuzzleBatch.h"
+#include "PuzzlePool.h"
+#include "GenerateStats.h"
+#include "BoardFile.h"
+#include "UnitCheck.h"
 
 
 
@@ -54,6 +65,7 @@ void freeGameBoards (Game * game){
 	freeBoardMem(game->gameBoard, game->N);
 	freeBoardMem(game->solvedBoard, game->N);
 	freeBoardMem(game->originalBoard, game->N);
+	game->boardVersion++;
 }
 
 
@@ -61,10 +73,7 @@ void freeGameBoards (Game * game){
 /***** Initialization *****/
 
 void initMovesList(Game * game) {
-	game->moves = (LinkedList*) malloc(sizeof(LinkedList));
-	game->moves->head = NULL;
-	game->moves->tail = NULL;
-	game->moves->movePointer = NULL;
+	game->moves = createMoveLog(game->maxMoves);
 }
 
 /*
@@ -85,12 +94,31 @@ void initalizeGameBoards(Game * game, int m, int n){
 	allocateboardMem (&(game->gameBoard), game->N);
 	allocateboardMem (&(game->originalBoard), game->N);
 	allocateboardMem(&(game->solvedBoard), game->N);
+	game->boardVersion++;
 }
 
-void initalizeGameAtINIT(Game* game, int initializeMarkErrors){
+void initalizeGameAtINIT(Game* game, int initializeSettings){
 	game->gameMode = INIT_MODE;
-	if(initializeMarkErrors == 1) {
+	if(initializeSettings == 1) {
 		game->markErrors = 1;
+		game->journal = NULL;
+		game->printer = createBoardPrinter();
+		game->quiet = 0;
+		game->protocolMode = 0;
+		game->boardVersion = 0;
+		game->jobs = NULL;
+		game->solverPool = NULL;
+		game->speculate = 1;
+		game->speculation = NULL;
+		game->portfolio = 0;
+		seedRandomFromClock(&game->random);
+		game->poolSize = 0;
+		game->pool = NULL;
+		game->timeLimit = 0;
+		game->generateStatsPath = NULL;
+		game->generateStats = NULL;
+		game->isGenerateStatsShared = 0;
+		game->maxMoves = MAX_RETAINED_MOVES;
 	}
 	game->gameOver = 0;
 	game->gameBoard = NULL;
@@ -98,6 +126,7 @@ void initalizeGameAtINIT(Game* game, int initializeMarkErrors){
 	game->solvedBoard = NULL;
 	initMovesList(game);
 	game->isErroneous = 0;
+	game->numOfErroneousCells = 0;
 	game->isSolvable = 0;
 }
 
@@ -107,89 +136,92 @@ void initalizeGameAtINIT(Game* game, int initializeMarkErrors){
 
 /*
  * gets file pointer and pointer to the game
- * read m,n and cell values from the file
- * and initialize the boards with those values
+ * read m,n and cell values from the file into m, n and the newly allocated
+ * N*N boards values and fixedValues (only fixed cells are loaded to fixedValues).
+ * the game boards aren't touched, so a rejected file leaves the loaded game as is.
+ * returns 1 on success, 0 (nothing is allocated) if m or n is missing or isn't a positive number,
+ * the board is larger than BINARY_BOARD_MAX_N, or a cell token isn't a number in 0..N.
  *
- * NOTE: the function can deal with any type and amount of spaces -
- * they won't be read into the boards
+ * NOTE: the file is read with a single pass tokenizer (see BoardFile.h),
+ * so the function can deal with any type and amount of spaces -
+ * they won't be read into the boards.
+ * cells that are missing from the file are set to 0.
  */
-void readBoardValuesFromFile (FILE * fp, Game * game){
-
-	/* booleans */
-	int readm = 0; /* 1 iff we read m */
-	int readn = 0; /* 1 iff we read n */
-	int done = 0;	/* 1 iff we read all the board cell */
-
-	char * line;
-	char * parsedLine;
-
-	int n;
-	int m;
-
-	/*readCellCnt counts the number of board cells that we read from the file*/
-	int readCellCnt = 0;
+int readBoardValuesFromFile (FILE * fp, Game * game, int * m, int * n, int *** values, int *** fixedValues){
+	TextBoardReader reader;
+	int N;
+	int value;
+	int hasDot;
 	int i;
 	int j;
 
-	line = getLine(fp);
-	/* read all lines and split each line according to delimiter */
-	while (line != NULL){
-		parsedLine = strtok(line, DELIMITER);
-		while (parsedLine != NULL){
-			/* first read m */
-			if (readm == 0){
-				m = atoi (parsedLine);
-				readm = 1;
+	initTextBoardReader(&reader, fp);
+
+	/* first read m and n, then read board cells values */
+	if (readTextBoardToken(&reader, m, &hasDot) == 0 || readTextBoardToken(&reader, n, &hasDot) == 0 ||
+			*m <= 0 || *n <= 0 || *m > BINARY_BOARD_MAX_N / *n){
+		freeTextBoardReader(&reader);
+		return 0;
+	}
+	N = (*m) * (*n);
+	allocateboardMem(values, N);
+	allocateboardMem(fixedValues, N);
+
+	for (i = 0; i < N; i++){
+		for (j = 0; j < N; j++){
+			if (readTextBoardToken(&reader, &value, &hasDot) == 0){
+				value = 0;
+				hasDot = 0;
+			}
+			if (value < 0 || value > N){
+				freeBoardMem(*values, N);
+				freeBoardMem(*fixedValues, N);
+				freeTextBoardReader(&reader);
+				return 0;
 			}
-			/* then read n */
-			else if (readn == 0){
-				n = atoi (parsedLine);
-				readn = 1;
-				initalizeGameBoards(game, m, n);
+			(*values)[i][j] = value;
+			/* 1. in Edit mode - none of the cells is loaded as Fixed cell
+			 * 2. only fixed cells are loaded to original board
+			 */
+			if (game->gameMode != EDIT_MODE && hasDot == 1){
+				(*fixedValues)[i][j] = value;
 			}
-			/* if we already read m and m - read board cells values */
 			else{
-				i = readCellCnt / game->N;
-				j = readCellCnt % game->N;
-
-				game->gameBoard[i][j] = atoi(parsedLine);
-				/* 1. in Edit mode - none of the cells is loaded as Fixed cell
-				 * 2. only fixed cells are loaded to original board
-				 */
-				if (game->gameMode != EDIT_MODE &&
-						strstr(parsedLine,FIXED_CELL_DOT) !=  NULL){
-					game->originalBoard[i][j] = game->gameBoard[i][j];
-				}
-				else{
-					game->originalBoard[i][j] = 0;
-				}
-
-				readCellCnt++;
-				/* if we read N*N cell values from the file - change done to 1
-				 * and then get out of the loop*/
-				if(readCellCnt == game->N * game->N) {
-					done = 1;
-					break;
-				}
+				(*fixedValues)[i][j] = 0;
 			}
-			parsedLine = strtok(NULL, DELIMITER);
 		}
-		free(line);
-		if(done == 1) {
-			return;
-		}
-		line = getLine(fp);
 	}
+
+	freeTextBoardReader(&reader);
+	return 1;
 }
 
 
+/*
+ * gets the game and a mapped binary board file,
+ * initialize the boards and copy the mapped cells to them.
+ * in Edit mode - none of the cells is loaded as Fixed cell
+ */
+void readBoardValuesFromBinaryFile (BinaryBoard * binaryBoard, Game * game){
+	initalizeGameBoards(game, binaryBoard->m, binaryBoard->n);
+	loadBinaryBoardCells(binaryBoard, game->gameBoard, game->originalBoard,
+			game->gameMode != EDIT_MODE);
+}
+
 /*
  * Gets game, file path and the command type
  * reads board values from the given filePath (if exists)
- * and loads them to the game board
+ * and loads them to the game board.
+ * the file format (text or binary) is detected by the file magic
  */
 int getBoardFromFile(Game * game, char * path, commandType type){
 	FILE *fp;
+	int isBinary;
+	BinaryBoard binaryBoard;
+	int m;
+	int n;
+	int ** values;
+	int ** fixedValues;
 
 	/*
 	 * open the file.
@@ -213,15 +245,40 @@ int getBoardFromFile(Game * game, char * path, commandType type){
 		return 0;
 	}
 
+	/*
+	 * a binary board file is mapped to memory, a text board file is read to new boards.
+	 * if it can't be mapped or read or it doesn't describe a valid board -
+	 * prints error and the command isn't executed
+	 */
+	isBinary = isBinaryBoardFile(fp);
+	if ((isBinary == 1 && mapBinaryBoard(fp, &binaryBoard) == 0) ||
+			(isBinary == 0 && readBoardValuesFromFile(fp, game, &m, &n, &values, &fixedValues) == 0)){
+		printFileFormatError();
+		fclose(fp);
+		return 0;
+	}
+
 	/* free previous boards and moves list */
 	/* if there is another boards loaded to the game - erase it */
 	if(game->gameBoard != NULL){
 		freeGameBoards(game);
 	}
-	freeLinkedList(game->moves);
+	freeMoveLog(game->moves);
 
 	/* fill the game board and the original board with the given file values */
-	readBoardValuesFromFile(fp, game);
+	if (isBinary == 1){
+		readBoardValuesFromBinaryFile(&binaryBoard, game);
+		unmapBinaryBoard(&binaryBoard);
+	}
+	else{
+		game->n = n;
+		game->m = m;
+		game->N = n*m;
+		game->gameBoard = values;
+		game->originalBoard = fixedValues;
+		allocateboardMem(&(game->solvedBoard), game->N);
+		game->boardVersion++;
+	}
 
 	/* close the file and make sure the stream was successfully closed */
 	if (fclose(fp) != 0){
@@ -232,9 +289,9 @@ int getBoardFromFile(Game * game, char * path, commandType type){
 }
 
 /*
- * Save board values from game entity to a given file .
- *
- * The format of the file is as follows (a simple text file):
+ * Save board values from game entity to the file in the given path.
+ * if isBinary is 1 the board is saved in the binary board file format (see BoardFile.h),
+ * otherwise - the format of the file is as follows (a simple text file):
  * 1. The first line contains the block size m n.
  * 	  These are two integers, separated by a single space.
  * 2. Each line contains a single row of the board.
@@ -242,34 +299,29 @@ int getBoardFromFile(Game * game, char * path, commandType type){
  *  	i.  the value in empty cells is 0.
  * 		ii. if the cell is "fixed", follow its value with a dot '.'
  *
+ * The board is formatted into a single buffer, which atomically replaces the file content.
  * The function return value is 1 if the writing succeed,
  * but if there was a problem - the return value is 0
 */
 
-int saveBoardToFile (Game game,  FILE * fp){
-	int i;
-	int j;
+int saveBoardToFile (Game game, char * path, int isBinary){
+	char * data;
+	long len;
+	int saved;
+	/* mark cell as Fixed:
+	 * in case the cell is Fixed or we're in Edit mode */
+	int allFilledFixed = game.gameMode == EDIT_MODE;
 
-	/* print m an n to the file */
-	fprintf(fp,"%d%s%d%s",game.m, SPACE, game.n, NEW_LINE);
-
-	/* write cells value to the file line by line according to format rules */
-	for (i = 0; i< game.N; i++){
-		for (j = 0; j< game.N; j++){
-			fprintf(fp,"%d",abs(game.gameBoard[i][j]));
-			/* mark cell as Fixed:
-			 * in case the cell is Fixed or we're in Edit mode */
-			if ((game.gameMode == EDIT_MODE && game.gameBoard [i][j] !=0)
-					|| game.originalBoard[i][j] != 0){
-				fprintf(fp,"%s", FIXED_CELL_DOT);
-			}
-			if (j < game.N-1) {
-				fprintf(fp,"%s", SPACE);
-			}
-		}
-		fprintf(fp,"%s", NEW_LINE);
+	/* the whole file is formatted in memory, then written at once */
+	if (isBinary == 1){
+		data = formatBinaryBoard(game.gameBoard, game.originalBoard, game.m, game.n, allFilledFixed, &len);
 	}
-	return 1;
+	else{
+		data = formatTextBoard(game.gameBoard, game.originalBoard, game.m, game.n, allFilledFixed, &len);
+	}
+	saved = replaceFileAtomically(path, data, len);
+	free(data);
+	return saved;
 }
 
 
@@ -360,37 +412,18 @@ void setBoardPositive(Game * game) {
 }
 
 /*
- * Go over the game board up-down, left to right.
- * for each cell <i,j>, check if there is an error in the cell row (i),
- * col (j) and block. if an error was found - the cell is marked as negative
- * (mark flag = 1), as explained in Game.h.
+ * Clear the previous error marks, then mark as negative every cell whose value repeats
+ * in its row, column or block, as explained in Game.h.
+ * The units are checked with a single pass each, by the unit check kernels (see UnitCheck.h).
  *
- * The function updates isErroneous value to 1 if an error was found.
+ * The function updates isErroneous value to 1 if an error was found,
+ * and numOfErroneousCells to the number of cells that were marked.
  */
 void checkAndMarkBoardErros(Game * game){
-	int i;
-	int j;
-	int foundError = 0;
-
 	setBoardPositive(game);
 
-	for (i = 0; i < game->N; i++){
-		for (j = 0; j < game->N; j++){
-			if (game->gameBoard[i][j] != 0){
-				foundError += checkAndMarkBoardErrorsInRow(game, i, j,1);
-				foundError += checkAndMarkBoardErrorsInCol(game, i, j,1);
-				foundError += checkAndMarkBoardErrorsInBlock(game, i, j,1);
-			}
-		}
-	}
-
-	if(foundError != 0) {
-		game->isErroneous = 1;
-	}
-	else {
-		game->isErroneous = 0;
-		setBoardPositive(game);
-	}
+	game->numOfErroneousCells = markDuplicateValues(game->gameBoard, game->m, game->n);
+	game->isErroneous = game->numOfErroneousCells > 0;
 }
 
 /*
@@ -422,8 +455,358 @@ void updateErrorsAndEmptyCellNumAfterCellValueChange(Game * game, int newZ, int
 
 
 
+/***** Journal (internal functions) *****/
+
+/*
+ * print message to user, close the game journal and turn journaling off
+ * (used when the journal file cannot be written)
+ */
+void stopJournalOnError(Game * game){
+	printJournalWriteError();
+	closeJournal(game->journal);
+	game->journal = NULL;
+}
+
+/*
+ * if journaling is on - append a record to the game journal
+ */
+void appendToJournal(Game * game, int type, int row, int col, int value, int oldValue){
+	if(game->journal == NULL) {
+		return;
+	}
+	if(journalAppend(game->journal, type, row, col, value, oldValue) == 0) {
+		stopJournalOnError(game);
+	}
+}
+
+/*
+ * if journaling is on and a board is loaded -
+ * start the journal over with the current board as its header
+ */
+void startJournalSession(Game * game){
+	if(game->journal == NULL || game->gameMode == INIT_MODE) {
+		return;
+	}
+	if(journalWriteHeader(game->journal, game->gameMode, game->m, game->n,
+			game->gameBoard, game->originalBoard) == 0) {
+		stopJournalOnError(game);
+	}
+}
+
+/*
+ * apply the cell changes of the undo (isUndo = 1) or redo (isUndo = 0) move to the game board
+ * and move the current move pointer, without checking errors or printing
+ * (used when replaying a journal)
+ */
+void replayUndoRedoMove(Game * game, int isUndo){
+	int k;
+	int numOfChanges;
+	CellChange * changes;
+
+	numOfChanges = getMoveChanges(game->moves, isUndo, &changes);
+	for(k = 0; k < numOfChanges; k++) {
+		if(isUndo == 1) {
+			game->gameBoard[changes[k].row][changes[k].col] = changes[k].oldValue;
+		}
+		else {
+			game->gameBoard[changes[k].row][changes[k].col] = changes[k].value;
+		}
+	}
+	if(isUndo == 1) {
+		setMovePointerBackward(game->moves);
+	}
+	else {
+		setMovePointerForward(game->moves);
+	}
+}
+
+/*
+ * apply a single journal record to the game board and the moves log.
+ * inMove is 1 iff a move was begun and cell changes may be added to it.
+ * returns 1 iff the record is valid in the current game state
+ */
+int replayJournalRecord(Game * game, JournalRecord record, int * inMove){
+	int N = game->N;
+
+	switch(record.type) {
+		case JOURNAL_BEGIN_MOVE:
+			beginMove(game->moves);
+			*inMove = 1;
+			return 1;
+
+		case JOURNAL_CELL_CHANGE:
+			if(*inMove == 0 || record.row >= N || record.col >= N ||
+					abs(record.value) > N || abs(record.oldValue) > N) {
+				return 0;
+			}
+			addCellChange(game->moves, record.row, record.col, record.value, record.oldValue);
+			game->gameBoard[record.row][record.col] = record.value;
+			return 1;
+
+		case JOURNAL_UNDO:
+			*inMove = 0;
+			if(checkUndoAvailable(game->moves) == 0) {
+				return 0;
+			}
+			replayUndoRedoMove(game, 1);
+			return 1;
+
+		case JOURNAL_REDO:
+			*inMove = 0;
+			if(checkRedoAvailable(game->moves) == 0) {
+				return 0;
+			}
+			replayUndoRedoMove(game, 0);
+			return 1;
+
+		case JOURNAL_RESET:
+			*inMove = 0;
+			while(checkUndoAvailable(game->moves) == 1) {
+				replayUndoRedoMove(game, 1);
+			}
+			clearMoveLog(game->moves);
+			return 1;
+	}
+	return 0;
+}
+
+/*
+ * gets an open journal file after its header was read,
+ * loads the header board cells to the game boards and replays the journal records.
+ * returns the number of replayed records, or -1 if the header board is incomplete
+ */
+int replayJournal(Game * game, FILE * fp){
+	int i;
+	int j;
+	int value;
+	int isFixed;
+	int inMove = 0;
+	int numOfRecords = 0;
+	JournalRecord record;
+
+	for(i = 0; i < game->N; i++) {
+		for(j = 0; j < game->N; j++) {
+			if(readJournalCell(fp, &value, &isFixed) == 0 || value > game->N) {
+				return -1;
+			}
+			game->gameBoard[i][j] = value;
+			game->solvedBoard[i][j] = 0;
+			if(isFixed == 1) {
+				game->originalBoard[i][j] = value;
+			}
+			else {
+				game->originalBoard[i][j] = 0;
+			}
+		}
+	}
+
+	/* replay records up to the first incomplete or invalid record */
+	while(readJournalRecord(fp, &record) == 1 &&
+			replayJournalRecord(game, record, &inMove) == 1) {
+		numOfRecords++;
+	}
+	return numOfRecords;
+}
+
+
+
+/***** Solver core (internal functions) *****/
+
+/*
+ * updates game->isSolvable by the result of solving the game board (a sudokuResult, see Solver.h) within the deadline.
+ * returns 1 iff the solver worked, otherwise the error is printed (a memory allocation failure exits the program)
+ */
+int applySolverResult(Game * game, int result, SolverDeadline * deadline){
+	if (result == SUDOKU_OUT_OF_MEMORY){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	if (result == SUDOKU_TIMEOUT){
+		printTimeLimitReachedError(game->timeLimit, getSolverElapsedSeconds(deadline));
+		return 0;
+	}
+	if (result == SUDOKU_SOLVER_ERROR){
+		printGurobiError();
+		return 0;
+	}
+	game->isSolvable = result == SUDOKU_OK;
+	return 1;
+}
+
+/*
+ * run the ILP solver on the game board until the deadline - game->isSolvable is updated,
+ * and if the board is solvable its solution is put in game->solvedBoard.
+ * returns 1 iff the solver worked (a memory allocation failure exits the program)
+ */
+int solveGameBoardWithILP(Game * game, SolverDeadline * deadline){
+	return applySolverResult(game, solveBoardWithILPWithin(game->gameBoard, game->m, game->n, NULL, NULL, deadline,
+			game->solvedBoard), deadline);
+}
+
+/*
+ * solves the game board like solveGameBoardWithILP, with the ILP solver and the native backtracking solver
+ * racing each other (see Portfolio.h)
+ */
+int solveGameBoardWithPortfolio(Game * game, SolverDeadline * deadline){
+	return applySolverResult(game, solveBoardWithPortfolio(game->gameBoard, game->m, game->n, deadline,
+			game->solvedBoard, NULL), deadline);
+}
+
+/*
+ * tries to solve the game board with logic alone (see LogicSolver.h): if logic fills it completely, game->isSolvable is set
+ * and the solution is put in game->solvedBoard, and if logic finds a contradiction the board is unsolvable.
+ * returns 1 iff logic decided whether the board is solvable (a memory allocation failure exits the program)
+ */
+int solveGameBoardWithLogic(Game * game){
+	int result = solveBoardWithLogic(game->gameBoard, game->m, game->n, game->solvedBoard, NULL);
+
+	if (result == SUDOKU_OUT_OF_MEMORY){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	if (result == SUDOKU_UNDECIDED){
+		return 0;
+	}
+	game->isSolvable = result == SUDOKU_OK;
+	return 1;
+}
+
+/*
+ * returns the number of solutions of the game board, or -1 if the time limit passed first
+ * (the timeout is printed, and a memory allocation failure exits the program)
+ */
+int countGameBoardSolutions(Game * game){
+	SolverDeadline deadline;
+	int numSolutions;
+	int result;
+
+	setSolverDeadline(&deadline, game->timeLimit);
+	result = cntNumSolutionsUntil(game->gameBoard, game->m, game->n, isSolverDeadlinePassed, &deadline, &numSolutions);
+	if (result == SUDOKU_STOPPED){
+		printTimeLimitReachedError(game->timeLimit, getSolverElapsedSeconds(&deadline));
+		return -1;
+	}
+	if (result != SUDOKU_OK){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	return numSolutions;
+}
+
+
+/***** Speculative solving (internal functions) *****/
+
+/*
+ * starts a speculative ILP solve of the game board on the speculation worker (see speculate in Game.h),
+ * and cancels the solves of the previous board versions.
+ * nothing is printed: if the solve cannot be started, the commands just run the ILP themselves
+ */
+void speculateGameBoard(Game * game){
+	BackgroundJob * job;
+
+	if (game->speculate == 0 || game->gameMode == INIT_MODE){
+		return;
+	}
+	if (game->speculation == NULL){
+		game->speculation = createBackgroundJobs(SPECULATION_WORKERS, game->solverPool);
+		if (game->speculation == NULL){
+			game->speculate = 0;
+			return;
+		}
+	}
+
+	/* a queued outdated solve is skipped, a running one is stopped */
+	for (job = game->speculation->first; job != NULL; job = job->next){
+		cancelBackgroundJob(game->speculation, job);
+	}
+	while ((job = takeFinishedBackgroundJob(game->speculation)) != NULL){
+		freeBackgroundJob(game->speculation, job);
+	}
+
+	/* the commands don't solve an erroneous board */
+	if (game->isErroneous == 1){
+		return;
+	}
+	startBackgroundJob(game->speculation, VALIDATE, game->gameBoard, game->m, game->n, game->boardVersion, game->timeLimit);
+}
+
+/*
+ * if there is a speculative solve of the current board version - waits for it to finish,
+ * puts its result in game->isSolvable and game->solvedBoard and returns 1.
+ * returns 0 if there is no such solve or it failed (so the caller runs the ILP itself).
+ * with a time limit, an unfinished solve isn't waited for (the caller solves the board within the time limit).
+ * on the server solver pool, a solve that no worker took yet is canceled instead of waited for:
+ * the caller runs on a pool worker itself, and solves the board at once rather than wait behind other sessions
+ */
+int takeSpeculativeSolution(Game * game){
+	BackgroundJob * job;
+	int i;
+	int j;
+
+	if (game->speculation == NULL){
+		return 0;
+	}
+	/* the newest solve is the only one that isn't canceled */
+	job = game->speculation->last;
+	if (job == NULL || job->canceled == 1 || job->boardVersion != game->boardVersion){
+		return 0;
+	}
+	if (game->timeLimit > 0 && getBackgroundJobState(game->speculation, job) != JOB_FINISHED){
+		return 0;
+	}
+	if (game->solverPool != NULL && getBackgroundJobState(game->speculation, job) == JOB_QUEUED){
+		cancelBackgroundJob(game->speculation, job);
+		return 0;
+	}
+	waitBackgroundJob(game->speculation, job);
+
+	if (job->result == SUDOKU_UNSOLVABLE){
+		game->isSolvable = 0;
+		return 1;
+	}
+	if (job->result != SUDOKU_OK){
+		return 0;
+	}
+	for (i = 0; i < game->N; i++){
+		for (j = 0; j < game->N; j++){
+			game->solvedBoard[i][j] = job->solution[i][j];
+		}
+	}
+	game->isSolvable = 1;
+	return 1;
+}
+
+/*
+ * solves the game board like solveGameBoardWithILP (or with the portfolio solver, if it is on) within the game time limit,
+ * but uses the speculative solve of the current board if there is one
+ */
+int solveCurrentGameBoard(Game * game){
+	SolverDeadline deadline;
+
+	setSolverDeadline(&deadline, game->timeLimit);
+	if (takeSpeculativeSolution(game) == 1){
+		return 1;
+	}
+	if (game->portfolio == 1){
+		return solveGameBoardWithPortfolio(game, &deadline);
+	}
+	return solveGameBoardWithILP(game, &deadline);
+}
+
+
 /***** Auxiliary functions for user commands *****/
 
+/*
+ * print the board after a command changed or loaded it,
+ * unless automatic board prints are suppressed (quiet mode)
+ */
+void printBoardAfterCommand(Game * game) {
+	if (game->quiet == 1){
+		return;
+	}
+	printBoard(*game);
+}
+
 /*
  * gets an int x and a range.
  * return 1 iff x is in the requested range.
@@ -450,7 +833,7 @@ void genEmptyBoard(Game * game){
 	if(game->gameBoard != NULL){
 		freeGameBoards(game);
 	}
-	freeLinkedList(game->moves);
+	freeMoveLog(game->moves);
 
 	initalizeGameBoards(game, DEFAULT_BOARD_n, DEFAULT_BOARD_m);
 	for (i = 0; i < game->N; i++){
@@ -461,23 +844,10 @@ void genEmptyBoard(Game * game){
 	}
 	/* update isErroneous and numOfNonZeroCells values to zero */
 	game->isErroneous = 0;
+	game->numOfErroneousCells = 0;
 	game->numOfNonZeroCells = 0;
 }
 
-/* get pointer to a game and sets all boards cell to zero */
-void clearBoards(Game* game){
-	int i;
-	int j;
-
-	for (i = 0; i < game->N; i++){
-		for (j = 0; j < game->N ; j++){
-			game->gameBoard[i][j] = 0;
-			game->originalBoard[i][j] = 0;
-			game->solvedBoard[i][j] = 0;
-		}
-	}
-}
-
 /*
  * gets a pointer to game and checks if we got to the end of the game:
  * if non of the cells is empty and we are in solve mode:
@@ -498,7 +868,7 @@ void checkSolvedSuccessfullyAndFinish(Game * game){
 	    else {
 	        printPuzzleSolvedSuccessfullyMessage();
 	        freeGameBoards(game);
-	        freeLinkedList(game->moves);
+	        freeMoveLog(game->moves);
 	        initalizeGameAtINIT(game, 0);
 	    }
 	}
@@ -569,24 +939,22 @@ int cntNumOfNonZeroCell (Game * game){
  * in order of execution.
  */
 void undoRedoMove(Game * game, int isUndo, int toPrint) {
+	int k;
 	int x;
 	int y;
 	int z;
 	int oldZ;
-	InnerListNode * currMove;
+	int numOfChanges;
+	CellChange * changes;
 
-	if(isUndo == 1) {
-		currMove = game->moves->movePointer->move;
-	}
-	else {
-		currMove = game->moves->movePointer->next->move;
-	}
+	numOfChanges = getMoveChanges(game->moves, isUndo, &changes);
+	game->boardVersion++;
 
-	while(currMove != NULL) {
-		x = currMove->cellChange[0];
-		y = currMove->cellChange[1];
-		z = currMove->cellChange[2];
-		oldZ = currMove->cellChange[3];
+	for(k = 0; k < numOfChanges; k++) {
+		x = changes[k].row;
+		y = changes[k].col;
+		z = changes[k].value;
+		oldZ = changes[k].oldValue;
 		if(isUndo == 1){
 			game->gameBoard[x][y] = oldZ;
 			updateErrorsAndEmptyCellNumAfterCellValueChange(game,oldZ,z);
@@ -595,174 +963,74 @@ void undoRedoMove(Game * game, int isUndo, int toPrint) {
 			game->gameBoard[x][y] = z;
 			updateErrorsAndEmptyCellNumAfterCellValueChange(game,z,oldZ);
 		}
-		currMove = currMove->next;
 	}
 
 	if(toPrint == 0) {
 		return;
 	}
 
-	printBoard(*game);
-	if(isUndo == 1) {
-		currMove = game->moves->movePointer->move;
-	}
-	else {
-		currMove = game->moves->movePointer->next->move;
-	}
+	printBoardAfterCommand(game);
 
-	while(currMove != NULL) {
-		x = currMove->cellChange[0];
-		y = currMove->cellChange[1];
-		z = currMove->cellChange[2];
-		oldZ = currMove->cellChange[3];
+	for(k = 0; k < numOfChanges; k++) {
+		x = changes[k].row;
+		y = changes[k].col;
+		z = changes[k].value;
+		oldZ = changes[k].oldValue;
 		if(isUndo == 1){
 			printUndoRedoMove(x, y, z, oldZ,1);
 		}
 		else {
 			printUndoRedoMove(x, y, z, oldZ,0);
 		}
-		currMove = currMove->next;
 	}
 
 }
 
-/*
- * the function attempts to generate a game board using ILP
- * according to the supplied:
- * 1. x - number of cells to randomly fill
- * 2. y - number of cells not clear
- * 3. cellsArray - an N*N array, so that each array cell represent a game board cell
- * 				   in order to randomly choose cells to fill
- * 4. valuesArray - an N size array, so that each array cell represent a game board
- * 				   legal value (1-N), in order to randomly cell value
- *
- * The function return 1 iff a legal board was generated successfully.
- * If there was a problem with cells randomly filling, ILP solver failed or the board
- * is not solvable - the function returns 0.
- *
- * If a legal board was generated successfully,
- * the game board is updated with y randomly choose cells from the solution.
- * otherwise, the game board is set back to an empty board.
- */
-int attemptToGenerateBoard(Game * game, int x, int y, int * cellsArray, int * valuesArray){
-	int i;
-	int v;
-	int r;
-	int c;
-	int val;
-	int ILPSuccess;
-
-	int N = game->N;
-	int N2 = N*N;
-
-	/* shuffle the cells indexes array */
-	randomize(cellsArray, N2);
-	/*
-	 * for each of the first x cells in the shuffled cells indexes array:
-	 * shuffle the valuesArray and for each possible value -
-	 * try to put it in the current cell - if it's a legal placement ->
-	 * break and go to the next cell. if there is no legal value for the cell -
-	 * the function returns 0
-	 */
-	for (i = 0; i < x ; i++){
-		/* get board cell indexes */
-		r = cellsArray[i] / N;
-		c = cellsArray[i] % N;
-		/* shuffle the values array */
-		randomize(valuesArray, N);
-		for (v = 0; v < N ; v++){
-			val = valuesArray[v];
-			game->gameBoard[r][c] = val;
-			if (checkAndMarkBoardErrorsInCol(game, r, c, 0) == 0 &&
-					checkAndMarkBoardErrorsInRow(game, r, c, 0) == 0 &&
-					checkAndMarkBoardErrorsInBlock(game, r, c, 0) == 0){
-				break;
-			}
-			game->gameBoard[r][c] = 0;
-		}
-		/* if the cell doesn't have a legal value possibility - return 0 */
-		if (game->gameBoard[r][c] == 0){
-			return 0;
-		}
-	}
-
-	/* here - each one of the x cells has a legal value */
-	ILPSuccess = solveBoardWithILP(game);
-
-	/* if ILp failed or the generated board isn't solvable - return 0 */
-
-	if (ILPSuccess == 0){
-		printGurobiError();
-		return 0;
-	}
-
-	if (game->isSolvable == 0){
-		return 0;
-	}
-
-	/* here - a legal and solvable board was generated */
-
-	/* erase game board changes */
-	for (i = 0; i < x ; i++){
-		r = cellsArray[i] / N;
-		c = cellsArray[i] % N;
-		game->gameBoard[r][c] = 0;
-	}
-
-	/* randomly choose y cells not to be cleared */
-	randomize(cellsArray, N2);
-	for (i = 0; i < y; i++){
-		r = cellsArray[i] / N;
-		c = cellsArray[i] % N;
-		game->gameBoard[r][c] = game->solvedBoard[r][c];
-	}
-	return 1;
-}
-
 /*
  * Add generate move to the game undo-redo moves list.
  * The function clears any move beyond the current move from the list,
  * then add the new move to the end of the list and mark it as the current move.
  *
- * The added move has a pointer to a list of InnerListNodes,
- * describing each one of the values changes of the Y non-empty cells in generate operation,
- * in order (up-down, left-right).
+ * The added move has a cell change for each one of the values changes
+ * of the Y non-empty cells in generate operation, in order (up-down, left-right).
  */
 void addGenerateMoveToMovesList (Game * game){
 	int i;
 	int j;
-	InnerListNode * node;
-	InnerListNode * firstNode = NULL;
-	InnerListNode * prevNode = NULL;
 	int N = game->N;
 
-	/* clear any move (ListNode) beyond list->movePointer from the list */
-	deleteAfterPointer(game->moves);
+	/* clear any move beyond the current move from the log and start a new move */
+	beginMove(game->moves);
+	appendToJournal(game, JOURNAL_BEGIN_MOVE, 0, 0, 0, 0);
 
 	/*
 	 * go over the board up-down, left-right,
-	 * insert each non-empty cell to the inner list,
-	 * that describe the cell values changes.
+	 * add each non-empty cell to the move cell changes.
 	 */
 	for ( i = 0; i < N ; i++){
 		for (j = 0; j < N; j++){
 			if (game->gameBoard[i][j] != 0){
-				node = createInnerListNode(i,j,game->gameBoard[i][j],0);
-				if(prevNode != NULL){
-					prevNode->next = node;
-				}
-				else{
-					firstNode = node;
-				}
-				prevNode = node;
+				addCellChange(game->moves, i, j, game->gameBoard[i][j], 0);
+				appendToJournal(game, JOURNAL_CELL_CHANGE, i, j, game->gameBoard[i][j], 0);
 			}
 		}
 	}
-	insertAtTail(game->moves, firstNode);
+}
+
+/*
+ * returns the number of workers generate and generate_batch run on: a worker per processor (see getNumOfGenerateWorkers),
+ * or a single one in a server session, whose command already runs on a worker of the shared solver pool
+ */
+int getGameGenerateWorkers(Game * game){
+	if (game->solverPool != NULL){
+		return 1;
+	}
+	return getNumOfGenerateWorkers();
 }
 
 
 
+
 /***** User commands *****/
 
 void solve(Game * game, Command currCommand){
@@ -790,8 +1058,10 @@ void solve(Game * game, Command currCommand){
 	checkAndMarkBoardErros(game);
 	game->numOfNonZeroCells  = cntNumOfNonZeroCell(game);
 	initMovesList(game);
+	/* start the journal over with the loaded board */
+	startJournalSession(game);
 	/* print the board after loading it from the file */
-	printBoard(*game);
+	printBoardAfterCommand(game);
 	
 }
 
@@ -823,8 +1093,10 @@ void edit(Game * game, Command currCommand){
 	}
 	/* initialize new moves list */
 	initMovesList(game);
+	/* start the journal over with the loaded board */
+	startJournalSession(game);
 	/* print the board after loading it from the file */
-	printBoard(*game);
+	printBoardAfterCommand(game);
 }
 
 void markErrors(Game * game, Command currCommand){
@@ -845,75 +1117,83 @@ void markErrors(Game * game, Command currCommand){
 	}
 }
 
-void printBoard(Game game){
-	int i;
-	int j;
+void ttyRender(Game * game, Command currCommand){
+	/*
+	 * if desired command value is NOT 0 or 1 -
+	 * an error message is printed and the command is not executed
+	 */
+	if (currCommand.intArgs[0] != 0 && currCommand.intArgs[0] != 1){
+		printInvalidMarkErrorsValError();
+		return;
+	}
+	/* differential rendering needs a terminal to move the cursor in */
+	if (setBoardPrinterTtyMode(game->printer, currCommand.intArgs[0]) == 0){
+		printTtyRenderUnavailableError();
+	}
+}
 
-	for(i = 0 ;i < game.N ; i++){
-		/* print separator row at the beginning of each Block */
-		if(i % game.m == 0){
-			SeparatorRow(game.N, game.m);
-		}
+void portfolio(Game * game, Command currCommand){
+	/*
+	 * if desired command value is NOT 0 or 1 -
+	 * an error message is printed and the command is not executed
+	 */
+	if (currCommand.intArgs[0] != 0 && currCommand.intArgs[0] != 1){
+		printInvalidMarkErrorsValError();
+		return;
+	}
+	game->portfolio = currCommand.intArgs[0];
+}
 
-		for(j = 0; j < game.N ; j++){
-			/* print "|" at the beginning of each block row */
-			if(j % game.n == 0){
-				printf(PIPE);
-			}
-			/*
-			 * Each cell is represented as 4 characters:
-			 *		a. A space character.
-			 *		b. Two digits for the cell value
-			 *			1. in case of blank cell (game.gameBoard.arrayBoard[i][j] == 0 )
-			 *				=> we use double space
-			 *			2. else: we print the abs value of the cell (game.gameBoard.arrayBoard[i][j])
-			 *				(reminder : negative value stands for erroneous values)
-			 *		c.  1. A dot '.' for a fixed cell
-			 *			2. an asterisk '*' for an erroneous cell when in Edit mode or the "Mark errors" parameter is set to 1,
-			 *			3. space otherwise.
-			 *			(note: A fixed cell is never marked as erroneous)
-			 */
+void timeLimit(Game * game, Command currCommand){
+	/*
+	 * if desired command value is not in range -
+	 * an error message is printed and the command is not executed
+	 */
+	if (!inputInRange(currCommand.intArgs[0], 0, MAX_TIME_LIMIT)){
+		printValueNotInRangeError(0, MAX_TIME_LIMIT);
+		return;
+	}
+	game->timeLimit = currCommand.intArgs[0];
+}
 
-			/* a. space char */
-			printf(SPACE);
-			/* b. cell value */
-			if (game.gameBoard[i][j] != 0){
-				printf("%2d",abs(game.gameBoard[i][j]));
-			}
-			else {
-				printf (DOUBLE_SPACE);
-			}
-			/*
-			 * c.1 fixed cell (".")
-			 */
-			if (game.originalBoard[i][j] != 0){
-				printf(FIXED_CELL_DOT);
-			}
-			else {
-				/*
-				 * c.2 erroneous cell when "Mark errors" == 1 or when in Edit mode ("*")
-				 */
+void printBoard(Game game){
+	/*
+	 * the whole board is rendered into the printer frame buffer and printed at once.
+	 * erroneous cells are marked when in Edit mode or the "Mark errors" parameter is set to 1
+	 */
+	renderBoard(game.printer, game.gameBoard, game.originalBoard, game.m, game.n,
+			game.markErrors == 1 || game.gameMode == EDIT_MODE);
+	printBoardFrame(game.printer);
 
-				if (game.gameBoard[i][j] < 0
-					 && (game.markErrors == 1 || game.gameMode == EDIT_MODE)){
-					printf(ERR_VAL_ASTERISK);
-				}
-				/*
-				 * c.3 otherwise (" ")
-				 */
-				else {
-					printf(SPACE);
-				}
-			}
-		}
+	/* when only a window of the board is printed - the summary line covers the rest */
+	if (isBoardWindowed(game.printer, game.N) == 1){
+		printViewSummary(game.printer->firstRow + 1, game.printer->endRow,
+				game.printer->firstCol + 1, game.printer->endCol,
+				game.N, game.numOfNonZeroCells, game.numOfErroneousCells);
+	}
+}
+
+void view(Game * game, Command currCommand){
+	int row = currCommand.intArgs[0];
+	int col = currCommand.intArgs[1];
+	int height = currCommand.intArgs[2];
+	int width = currCommand.intArgs[3];
 
-		/* end of row */
-		printf (PIPE);
-		printf(NEW_LINE);
+	/* without params - the view is removed and the whole board is printed */
+	if (row == MISSING_INT_ARG){
+		setBoardPrinterView(game->printer, 0, 0, 0, 0);
+		return;
 	}
 
-	/* end of board separator row */
-	SeparatorRow(game.N, game.m);
+	/*
+	 * the view corner must be a board cell, and the view size must be positive
+	 * otherwise - an error message is printed and the command is not executed
+	 */
+	if (row < 1 || row > game->N || col < 1 || col > game->N || height < 1 || width < 1){
+		printValueNotInRangeError(1, game->N);
+		return;
+	}
+	setBoardPrinterView(game->printer, row - 1, col - 1, height, width);
 }
 
 void set(Game* game, Command currCommand) {
@@ -948,17 +1228,22 @@ void set(Game* game, Command currCommand) {
 	/* setCell Only sets the value of cell (x,y) to z*/
 	oldZ = game->gameBoard[y-1][x-1];
 	game->gameBoard[y-1][x-1] = z;
+	game->boardVersion++;
 
 	/* add to moves list */
 	addSetMoveToMovesList(game->moves, y-1, x-1, z, oldZ);
+	appendToJournal(game, JOURNAL_BEGIN_MOVE, 0, 0, 0, 0);
+	appendToJournal(game, JOURNAL_CELL_CHANGE, y-1, x-1, z, oldZ);
 
 	/* update errors and number of non empty cells */
 	updateErrorsAndEmptyCellNumAfterCellValueChange(game,z,oldZ);
 	/* print the board */
-	printBoard(*game);
+	printBoardAfterCommand(game);
 
 	checkSolvedSuccessfullyAndFinish(game);
 
+	/* solve the new board in the background */
+	speculateGameBoard(game);
 }
 
 void validate(Game* game){
@@ -968,9 +1253,8 @@ void validate(Game* game){
 		printBoardContainErrors();
 		return;
 	}
-	/* validates the board and update game->isSolvable field*/
-	if(solveBoardWithILP(game) == 0) {
-		printGurobiError();
+	/* validates the board and update game->isSolvable field (the solver errors are printed) */
+	if(solveCurrentGameBoard(game) == 0) {
 		return;
 	}
 	/* print message to user according to isSolvable result after validation */
@@ -984,17 +1268,26 @@ void validate(Game* game){
 }
 
 void generate(Game* game, Command currCommand){
+	int ** puzzle;
 	int i;
-	int * cellsNumberArr;
-	int * cellsValuesArr;
+	int result;
+	int numOfAttempts;
+	int isGenerated = 1; /* 0 iff the puzzle was ready in the pool */
+	SolverDeadline deadline;
 	/* x and y are the values supplied by the user
 	 * x - number of cells to randomly fill with legal values
 	 * y -  number of cells to keep on board after solving the board */
 	int x = currCommand.intArgs[0];
 	int y = currCommand.intArgs[1];
 	int N2 = game->N * game->N;
-	/* boolean for board generation success */
-	int generationSucceeded = 0;
+
+	/* generate auto chooses X by the statistics of the previous generates (loaded by the first generate auto) */
+	if (x == AUTO_INT_ARG){
+		if (game->generateStats == NULL){
+			game->generateStats = loadGenerateStats(game->generateStatsPath);
+		}
+		x = chooseGenerateSeedCount(game->generateStats, game->m, game->n);
+	}
 
 	/* if either X or Y is invalid
 	*  the program prints an error and the command is not executed
@@ -1015,50 +1308,106 @@ void generate(Game* game, Command currCommand){
 	if(y == 0) {
 		return;
 	}
+	if (currCommand.intArgs[0] == AUTO_INT_ARG){
+		printGenerateAutoSeedCount(x);
+	}
 
-	/* create an array in size NXN, where cell <i> value = i*/
-	cellsNumberArr = (int *)malloc(N2 * sizeof(int));
-	for (i = 0; i< N2; i++){
-		cellsNumberArr[i] = i;
+	/*
+	 * Attempt to generate board at most MAX_GENERATES_ATTEMPTS times, on parallel workers (see PuzzleGenerator.h),
+	 * until the time limit. the attempts are seeded by the game random generator, so a seeded game generates the same puzzles
+	 */
+	setSolverDeadline(&deadline, game->timeLimit);
+	puzzle = createBoardSnapshot(NULL, game->N);
+	if (puzzle == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	/* the pool is started with the first generate (if it cannot be started, the puzzle is just generated here) */
+	if (game->poolSize > 0 && game->pool == NULL){
+		game->pool = createPuzzlePool(game->poolSize, nextRandom(&game->random), MAX_GENERATES_ATTEMPTS);
+	}
+	if (game->pool != NULL){
+		result = takePooledPuzzle(game->pool, game->m, game->n, x, y, getGameGenerateWorkers(game), &deadline,
+				puzzle, game->solvedBoard, &numOfAttempts, &isGenerated);
+	}
+	else {
+		result = generatePuzzleWithin(game->m, game->n, x, y, nextRandom(&game->random), MAX_GENERATES_ATTEMPTS,
+				getGameGenerateWorkers(game), BACKEND_ILP, &deadline, puzzle, game->solvedBoard, &numOfAttempts);
+	}
+	if (result == SUDOKU_OUT_OF_MEMORY){
+		printMemoryAllocationError();
+		exit(0);
 	}
 
-	cellsValuesArr = (int *)malloc(game->N * sizeof(int));
-	for (i = 0; i< game->N; i++){
-		cellsValuesArr[i] = i+1;
+	/* the generation effort is learned from (a solver error says nothing about X, and a ready pooled puzzle took no time) */
+	if (game->generateStats != NULL && isGenerated == 1 && result != SUDOKU_SOLVER_ERROR &&
+			recordGenerateRun(game->generateStats, game->m, game->n, x, numOfAttempts, result == SUDOKU_OK,
+					getSolverElapsedSeconds(&deadline)) == 0){
+		printGenerateStatsSaveError(game->generateStatsPath);
 	}
 
-	/*
-	 * Attempt to generate board at most MAX_GENERATES_ATTEMPTS times
-	 * if one of the x randomly-chosen cells has no legal value available,
-	 * or the resulting board has no solution -
-	 * clear the board entirely and repeat the attempt to generate board
-	 */
-	for (i = 0; i<MAX_GENERATES_ATTEMPTS; i++){
-		generationSucceeded = attemptToGenerateBoard(game, x, y,cellsNumberArr, cellsValuesArr);
-		/* if the puzzle was generated successfully - print the board and update game attributes */
-		if (generationSucceeded == 1){
-			printBoard(*game);
-			game->numOfNonZeroCells = y;
-			game->isErroneous = 0;
-			addGenerateMoveToMovesList(game);
-			free(cellsNumberArr);
-			free(cellsValuesArr);
-			return;
+	/* if the puzzle was generated successfully - print the board and update game attributes */
+	if (result == SUDOKU_OK){
+		for (i = 0; i < game->N; i++){
+			memcpy(game->gameBoard[i], puzzle[i], game->N * sizeof(int));
 		}
-		clearBoards(game);
+		freeBoardSnapshot(puzzle);
+		game->isSolvable = 1;
+		game->numOfNonZeroCells = y;
+		game->isErroneous = 0;
+		game->numOfErroneousCells = 0;
+		game->boardVersion++;
+		/* with a time limit, the generation effort is reported */
+		if (game->timeLimit > 0){
+			printPuzzleGenerated(numOfAttempts, getSolverElapsedSeconds(&deadline));
+		}
+		printBoardAfterCommand(game);
+		addGenerateMoveToMovesList(game);
+		return;
 	}
+	freeBoardSnapshot(puzzle);
+
 	/* if we are here - board generation failed
 	 * print message to user and the command is not executed*/
-	free(cellsNumberArr);
-	free(cellsValuesArr);
+	if (result == SUDOKU_TIMEOUT){
+		printGenerateTimeLimitReachedError(numOfAttempts, getSolverElapsedSeconds(&deadline));
+		return;
+	}
+	if (result == SUDOKU_SOLVER_ERROR){
+		printGurobiError();
+	}
 	printPuzzleGeneratorFailedError();
 }
 
+void generateBatch(Game* game, Command currCommand){
+	int count = currCommand.intArgs[0];
+	int x = currCommand.intArgs[1];
+	int y = currCommand.intArgs[2];
+	int N2 = game->N * game->N;
+	SolverDeadline deadline;
+
+	if (!inputInRange(count, 1, MAX_BATCH_PUZZLES)){
+		printValueNotInRangeError(1, MAX_BATCH_PUZZLES);
+		return;
+	}
+	if (!inputInRange(x,0,N2) || !inputInRange(y,0,N2)){
+		printValueNotInRangeError(0, N2);
+		return;
+	}
+
+	/* the batch is seeded by the game random generator, so a seeded game writes the same pack (unless it times out) */
+	setSolverDeadline(&deadline, game->timeLimit);
+	generatePuzzleBatch(game->m, game->n, count, x, y, nextRandom(&game->random), MAX_GENERATES_ATTEMPTS,
+			getGameGenerateWorkers(game), &deadline, currCommand.filePath);
+}
+
 void undo(Game * game){
 	/* checks if undo command is available and if so - execute undo */
 	if(checkUndoAvailable(game->moves) == 1) {
 		undoRedoMove(game, 1,1);
 		setMovePointerBackward(game->moves);
+		appendToJournal(game, JOURNAL_UNDO, 0, 0, 0, 0);
+		speculateGameBoard(game);
 	}
 	/* if there are no moves to undo - print message to user
 	 * and the command is not executed
@@ -1074,6 +1423,8 @@ void redo(Game * game){
 	if(checkRedoAvailable(game->moves) == 1) {
 		undoRedoMove(game, 0,1);
 		setMovePointerForward(game->moves);
+		appendToJournal(game, JOURNAL_REDO, 0, 0, 0, 0);
+		speculateGameBoard(game);
 	}
 	/* if there are no moves to redo - print message to user
 	 * and the command is not executed
@@ -1086,8 +1437,8 @@ void redo(Game * game){
 
 void save(Game * game, Command currCommand){
 
-	FILE * fp;
 	int validSuccess;
+	int saved;
 
 	/* in Edit mode - if the board is erroneous -
 	 * the command is not executed and a message is printed to the user
@@ -1105,9 +1456,8 @@ void save(Game * game, Command currCommand){
 	 * 	3. otherwise - proceed normally
 	 */
 	if (game->gameMode == EDIT_MODE){
-		validSuccess = solveBoardWithILP(game);
+		validSuccess = solveCurrentGameBoard(game);
 		if (validSuccess == 0){
-			printGurobiError();
 			return;
 		}
 		if (game->isSolvable != 1){
@@ -1116,23 +1466,17 @@ void save(Game * game, Command currCommand){
 		}
 	}
 
-	/* open the file path to write board game to */
-	fp = fopen(currCommand.filePath, "w");
-	if (fp == NULL){
-		printFileCreationError();
-		/* command isn't executed */
-		return;
-	}
 	/* if no errors occur then the game board is saved to the file
-	 * in the required file format
-	 * and a message is printed to the user */
-	if (saveBoardToFile (*game, fp) == 1 ){
+	 * in the required file format (binary iff the binary flag was supplied)
+	 * and a message is printed to the user.
+	 * the file is replaced atomically, so on failure its previous content is kept */
+	saved = saveBoardToFile (*game, currCommand.filePath, currCommand.intArgs[0]);
+	if (saved == 1){
 		printSavedToFile(currCommand.filePath);
 	}
-
-	if (fclose(fp) != 0){
-		printFileCloseError();
-		exit(0);
+	else{
+		/* command isn't executed */
+		printFileCreationError();
 	}
 }
 
@@ -1175,9 +1519,9 @@ void hint(Game * game, Command currCommand){
 		return;
 	}
 
-	/* validates the board and update game->isSolvable field*/
-	if(solveBoardWithILP(game) == 0) {
-		printGurobiError();
+	/* validates the board and update game->isSolvable field (the solver errors are printed),
+	 * with logic alone when it decides the board */
+	if(solveGameBoardWithLogic(game) == 0 && solveCurrentGameBoard(game) == 0) {
 		return;
 	}
 	/* print message to user according to isSolvable result after validation
@@ -1192,8 +1536,6 @@ void hint(Game * game, Command currCommand){
 }
 
 void numSolutions(Game * game){
-	int i;
-	int j;
 	int numSolutions;
 
 	/* if the board is erroneous - print message to user
@@ -1203,30 +1545,19 @@ void numSolutions(Game * game){
 		return;
 	}
 
-	/* copy game board to solved board */
-	for (i = 0; i< game->N; i++){
-		for(j = 0; j< game->N; j++){
-			game->solvedBoard[i][j] = game->gameBoard[i][j];
-		}
-	}
-
 	/* get board num of solutions - if the board is already filled - return 1 instead of running BT algo */
 	if(game->numOfNonZeroCells == game->N * game->N) {
 		numSolutions = 1;
 	}
 	else {
-		numSolutions = cntNumSolutions(game);
+		numSolutions = countGameBoardSolutions(game);
+		if (numSolutions < 0){
+			return;
+		}
 	}
 	/* print the board num of solutions */
 	printNumOfBoardSolutions(numSolutions);
 
-	/* copy solved board to game board */
-	for (i = 0; i< game->N; i++){
-		for(j = 0; j< game->N; j++){
-			game->gameBoard[i][j] = game->solvedBoard[i][j];
-		}
-	}
-
 	/* print an additional message according to board num of solutions */
 	if (numSolutions == 1){
 		printOnlyOneSolution();
@@ -1239,10 +1570,10 @@ void numSolutions(Game * game){
 void autofill(Game * game){
 	int i;
 	int j;
+	int k;
 	int onlyLegalValueForCell;
-	InnerListNode * firstNode = NULL;
-	InnerListNode * currNode = NULL;
-	InnerListNode * prevNode = NULL;
+	int numOfChanges = 0;
+	CellChange * changes;
 
 	/* if the board is erroneous - print message to user
 	 * and the command is not executed*/
@@ -1259,43 +1590,118 @@ void autofill(Game * game){
 			}
 			onlyLegalValueForCell = getCellObiviousValue(game,i,j);
 			if (onlyLegalValueForCell != 0){
-				currNode = createInnerListNode(i,j,onlyLegalValueForCell,0);
-				if(prevNode != NULL){
-					prevNode->next = currNode;
-				}
-				else{
-					firstNode = currNode;
+				/*
+				 * the first obvious value starts the autofill move:
+				 * clear any move beyond the current move from the log and start a new move
+				 */
+				if (numOfChanges == 0){
+					beginMove(game->moves);
+					appendToJournal(game, JOURNAL_BEGIN_MOVE, 0, 0, 0, 0);
 				}
-				prevNode = currNode;
+				addCellChange(game->moves, i, j, onlyLegalValueForCell, 0);
+				appendToJournal(game, JOURNAL_CELL_CHANGE, i, j, onlyLegalValueForCell, 0);
+				numOfChanges++;
 			}
 		}
 	}
 
 	/* if autofill didn't change the board */
-	if (firstNode == NULL){
-		printBoard(*game);
+	if (numOfChanges == 0){
+		printBoardAfterCommand(game);
 		return;
 	}
 
-	currNode = firstNode;
-	while (currNode != NULL){
-		i = currNode->cellChange[0];
-		j = currNode->cellChange[1];
-		onlyLegalValueForCell = currNode->cellChange[2];
+	/* get the autofill move cell changes (the current move) and update the board */
+	getMoveChanges(game->moves, 1, &changes);
+	game->boardVersion++;
+	for (k = 0; k < numOfChanges; k++){
+		i = changes[k].row;
+		j = changes[k].col;
+		onlyLegalValueForCell = changes[k].value;
 		/* update cell <i,j> value */
 		game->gameBoard[i][j] = onlyLegalValueForCell;
 		game->numOfNonZeroCells++;
 		printCellSetTo(i,j,onlyLegalValueForCell);
-		currNode = currNode->next;
 	}
     checkAndMarkBoardErros(game);
-	printBoard(*game);
+	printBoardAfterCommand(game);
 
-	/* clear any move (ListNode) beyond list->movePointer from the list */
-	deleteAfterPointer(game->moves);
-	insertAtTail(game->moves, firstNode);
+	checkSolvedSuccessfullyAndFinish(game);
+
+	/* solve the new board in the background */
+	speculateGameBoard(game);
+}
+
+void logicSolve(Game * game){
+	LogicStats stats;
+	int ** logicBoard;
+	int result;
+	int technique;
+	int i;
+	int j;
+	int numOfChanges = 0;
+
+	/* if the board is erroneous - print message to user
+	 * and the command is not executed*/
+	if (game->isErroneous == 1){
+		printBoardContainErrors();
+		return;
+	}
+
+	logicBoard = createBoardSnapshot(game->gameBoard, game->N);
+	if (logicBoard == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	result = solveBoardWithLogic(game->gameBoard, game->m, game->n, logicBoard, &stats);
+	if (result == SUDOKU_OUT_OF_MEMORY){
+		printMemoryAllocationError();
+		exit(0);
+	}
+
+	/* the cells logic filled are a single move (if it didn't find a contradiction) */
+	for (i = 0; i < game->N && result != SUDOKU_UNSOLVABLE; i++){
+		for (j = 0; j < game->N; j++){
+			if (game->gameBoard[i][j] != 0 || logicBoard[i][j] == 0){
+				continue;
+			}
+			if (numOfChanges == 0){
+				beginMove(game->moves);
+				appendToJournal(game, JOURNAL_BEGIN_MOVE, 0, 0, 0, 0);
+			}
+			addCellChange(game->moves, i, j, logicBoard[i][j], 0);
+			appendToJournal(game, JOURNAL_CELL_CHANGE, i, j, logicBoard[i][j], 0);
+			game->gameBoard[i][j] = logicBoard[i][j];
+			game->numOfNonZeroCells++;
+			printCellSetTo(i, j, logicBoard[i][j]);
+			numOfChanges++;
+		}
+	}
+	freeBoardSnapshot(logicBoard);
+
+	for (technique = 0; technique < NUM_OF_LOGIC_TECHNIQUES; technique++){
+		printLogicTechniqueStats(getLogicTechniqueName(technique), stats.filledCells[technique],
+				stats.eliminatedCandidates[technique], stats.seconds[technique]);
+	}
+	if (result == SUDOKU_UNSOLVABLE){
+		printLogicSolveContradictionError();
+		return;
+	}
+	printLogicSolveSummary(numOfChanges, game->N*game->N - game->numOfNonZeroCells);
+
+	/* if logic didn't change the board */
+	if (numOfChanges == 0){
+		printBoardAfterCommand(game);
+		return;
+	}
+	game->boardVersion++;
+	checkAndMarkBoardErros(game);
+	printBoardAfterCommand(game);
 
 	checkSolvedSuccessfullyAndFinish(game);
+
+	/* solve the new board in the background */
+	speculateGameBoard(game);
 }
 
 void reset(Game* game){
@@ -1304,21 +1710,291 @@ void reset(Game* game){
 		undoRedoMove(game, 1,0);
 		setMovePointerBackward(game->moves);
 	}
-	/* after reverting all the moves - clear moves list
-	 * (keep only sentinels)
+	/* after reverting all the moves - clear moves log
 	 * and print message to user
 	 */
-	if(game->moves->head != NULL) {
-		freeLinkedListFromStartPoint(game->moves->head->next);
-	}
+	clearMoveLog(game->moves);
+	appendToJournal(game, JOURNAL_RESET, 0, 0, 0, 0);
 	printResetMessage();
 }
 
 void exitGame(Game * game){
+	freeBackgroundJobs(game->jobs);
+	game->jobs = NULL;
+	freeBackgroundJobs(game->speculation);
+	game->speculation = NULL;
+	freePuzzlePool(game->pool);
+	game->pool = NULL;
+	if (game->isGenerateStatsShared == 0){
+		freeGenerateStats(game->generateStats);
+	}
+	game->generateStats = NULL;
 	if (game->gameMode != INIT_MODE){
 		freeGameBoards(game);
 	}
-	freeLinkedList(game->moves);
+	freeMoveLog(game->moves);
+	if (closeJournal(game->journal) == 0){
+		printJournalWriteError();
+	}
+	game->journal = NULL;
+	freeBoardPrinter(game->printer);
+	game->printer = NULL;
 	printExiting();
 	game->gameOver = 1;
 }
+
+void journal(Game * game, Command currCommand){
+	/* close the previous journal, if such exists */
+	if (closeJournal(game->journal) == 0){
+		printJournalWriteError();
+	}
+	game->journal = NULL;
+
+	/* if no file path was supplied - journaling is off */
+	if (currCommand.filePath == NULL){
+		printJournalStopped();
+		return;
+	}
+
+	game->journal = openJournal(currCommand.filePath, -1);
+	if (game->journal == NULL){
+		printJournalFileError();
+		return;
+	}
+	printJournalStarted(currCommand.filePath);
+
+	/* if a board is loaded - it is the journal header */
+	startJournalSession(game);
+}
+
+void recover(Game * game, Command currCommand){
+	FILE * fp;
+	int mode;
+	int m;
+	int n;
+	int numOfRecords;
+
+	fp = fopen(currCommand.filePath, "rb");
+	if (fp == NULL){
+		printJournalFileError();
+		return;
+	}
+	if (readJournalHeader(fp, &mode, &m, &n) == 0 ||
+			(mode != SOLVE_MODE && mode != EDIT_MODE)){
+		printFileFormatError();
+		fclose(fp);
+		return;
+	}
+
+	/* free previous boards and moves list */
+	if(game->gameBoard != NULL){
+		freeGameBoards(game);
+	}
+	freeMoveLog(game->moves);
+
+	game->gameMode = mode;
+	initalizeGameBoards(game, m, n);
+	initMovesList(game);
+
+	numOfRecords = replayJournal(game, fp);
+	if (fclose(fp) != 0){
+		printFileCloseError();
+		exit(0);
+	}
+
+	/* an incomplete header board can't be recovered - go back to Init mode */
+	if (numOfRecords < 0){
+		printFileFormatError();
+		freeGameBoards(game);
+		freeMoveLog(game->moves);
+		initalizeGameAtINIT(game, 0);
+		return;
+	}
+
+	/* update according to the recovered board:
+	 * 1. number of non empty cell
+	 * 2. isErroneous and mark cells with erroneous values (as negatives)
+	 */
+	checkAndMarkBoardErros(game);
+	game->numOfNonZeroCells = cntNumOfNonZeroCell(game);
+
+	/* continue journaling into the recovered journal, after the last valid record */
+	if (closeJournal(game->journal) == 0){
+		printJournalWriteError();
+	}
+	game->journal = openJournal(currCommand.filePath, getJournalLength(game->N, numOfRecords));
+	if (game->journal == NULL){
+		printJournalFileError();
+	}
+
+	printJournalRecovered(numOfRecords);
+	printBoardAfterCommand(game);
+}
+
+void commitJournal(Game * game){
+	if(game->journal != NULL && journalCommit(game->journal) == 0) {
+		stopJournalOnError(game);
+	}
+}
+
+
+/***** Background jobs *****/
+
+/*
+ * returns the name of the command the background job runs
+ */
+char * getJobCommandName(BackgroundJob * job){
+	if (job->type == VALIDATE){
+		return VALIDATE_STR;
+	}
+	return NUM_SOLUTIONS_STR;
+}
+
+/*
+ * prints the result of a finished background job, marked as stale if the board changed since the job started.
+ * the result of a canceled job isn't printed
+ */
+void reportJobResult(Game * game, BackgroundJob * job){
+	if (job->canceled == 1){
+		return;
+	}
+	printJobDone(job->id, getJobCommandName(job), job->boardVersion != game->boardVersion);
+
+	if (job->result == SUDOKU_OUT_OF_MEMORY){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	if (job->result == SUDOKU_SOLVER_ERROR){
+		printGurobiError();
+		return;
+	}
+	/* the job was limited by the time limit of the game when it started */
+	if (job->result == SUDOKU_TIMEOUT){
+		printTimeLimitReachedError(job->timeLimit, getSolverElapsedSeconds(&job->deadline));
+		return;
+	}
+	if (job->type == VALIDATE){
+		if (job->result == SUDOKU_OK){
+			printValidationPassed();
+		}
+		else {
+			printValidationFailed();
+		}
+		return;
+	}
+	printNumOfBoardSolutions(job->numOfSolutions);
+	if (job->numOfSolutions == 1){
+		printOnlyOneSolution();
+	}
+	else if (job->numOfSolutions > 1) {
+		printMoreThanOneSolution();
+	}
+}
+
+/*
+ * returns the background job with the given number, unless it doesn't exist or was canceled
+ * (in which case an error is printed and NULL is returned)
+ */
+BackgroundJob * getActiveJob(Game * game, int id){
+	BackgroundJob * job = NULL;
+
+	if (game->jobs != NULL){
+		job = findBackgroundJob(game->jobs, id);
+	}
+	if (job == NULL || job->canceled == 1){
+		printNoSuchJobError(id);
+		return NULL;
+	}
+	return job;
+}
+
+void runInBackground(Game * game, Command currCommand){
+	BackgroundJob * job;
+
+	/* the same checks as the command itself */
+	if (game->isErroneous == 1){
+		printBoardContainErrors();
+		return;
+	}
+
+	/* the workers are started by the first background command (a server session uses the server workers) */
+	if (game->jobs == NULL){
+		game->jobs = createBackgroundJobs(BACKGROUND_JOB_WORKERS, game->solverPool);
+		if (game->jobs == NULL){
+			printBackgroundJobsUnavailableError();
+			return;
+		}
+	}
+
+	job = startBackgroundJob(game->jobs, currCommand.type, game->gameBoard, game->m, game->n, game->boardVersion,
+			game->timeLimit);
+	if (job == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	printJobStarted(job->id, getJobCommandName(job));
+}
+
+void listJobs(Game * game){
+	BackgroundJob * job;
+	int numOfJobs = 0;
+	int state;
+
+	if (game->jobs != NULL){
+		for (job = game->jobs->first; job != NULL; job = job->next){
+			if (job->canceled == 1){
+				continue;
+			}
+			state = getBackgroundJobState(game->jobs, job);
+			printJobState(job->id, state == JOB_QUEUED ? "Queued" : state == JOB_RUNNING ? "Running" : "Done",
+					getJobCommandName(job), job->boardVersion != game->boardVersion);
+			numOfJobs++;
+		}
+	}
+	if (numOfJobs == 0){
+		printNoBackgroundJobs();
+	}
+}
+
+void waitJobs(Game * game, Command currCommand){
+	BackgroundJob * job;
+
+	if (currCommand.intArgs[0] != MISSING_INT_ARG){
+		job = getActiveJob(game, currCommand.intArgs[0]);
+		if (job == NULL){
+			return;
+		}
+		waitBackgroundJob(game->jobs, job);
+	}
+	else if (game->jobs != NULL){
+		/* a canceled job may still be running, its result isn't waited for */
+		for (job = game->jobs->first; job != NULL; job = job->next){
+			if (job->canceled == 0){
+				waitBackgroundJob(game->jobs, job);
+			}
+		}
+	}
+	reportFinishedJobs(game);
+}
+
+void cancelJob(Game * game, Command currCommand){
+	BackgroundJob * job = getActiveJob(game, currCommand.intArgs[0]);
+
+	if (job == NULL){
+		return;
+	}
+	cancelBackgroundJob(game->jobs, job);
+	printJobCanceled(job->id, getJobCommandName(job));
+}
+
+void reportFinishedJobs(Game * game){
+	BackgroundJob * job;
+
+	if (game->jobs == NULL){
+		return;
+	}
+	while ((job = takeFinishedBackgroundJob(game->jobs)) != NULL){
+		reportJobResult(game, job);
+		freeBackgroundJob(game->jobs, job);
+	}
+}
@@ -8,23 +8,37 @@
 *         void initMovesList(Game * game)
 *         void initalizeGameBoards(Game * game, int m, int n)
 *         void freeGameBoards (Game * game)
-*         void initalizeGameAtINIT(Game* game)
+*         void initalizeGameAtINIT(Game* game, int initializeSettings)
 *
 *         void solve(Game * game, Command currCommand)
 *         void edit(Game * game, Command currCommand)
 *         void markErrors(Game * game, Command currCommand)
+*         void ttyRender(Game * game, Command currCommand)
+*         void portfolio(Game * game, Command currCommand)
+*         void timeLimit(Game * game, Command currCommand)
+*         void view(Game * game, Command currCommand)
 *         void printBoard(Game game)
 *         void set(Game * game, Command currCommand)
 *         void validate(Game* game)
 *         void generate(Game* game, Command currCommand)
+*         void generateBatch(Game* game, Command currCommand)
 *         void undo(Game * game)
 *         void redo(Game * game)
 *         void save(Game * game, Command currCommand)
 *         void hint(Game * game, Command currCommand)
 *         void numSolutions(Game * game)
 *         void autofill(Game * game)
+*         void logicSolve(Game * game)
 *         void reset(Game * game)
 *         void exitGame(Game * game)
+*         void journal(Game * game, Command currCommand)
+*         void recover(Game * game, Command currCommand)
+*         void commitJournal(Game * game)
+*         void runInBackground(Game * game, Command currCommand)
+*         void listJobs(Game * game)
+*         void waitJobs(Game * game, Command currCommand)
+*         void cancelJob(Game * game, Command currCommand)
+*         void reportFinishedJobs(Game * game)
 *
 *         int checkAndMarkBoardErrorsInRow(Game * game, int i, int j, int mark)
 *         int checkAndMarkBoardErrorsInCol(Game * game, int i, int j, int mark)
@@ -46,15 +60,36 @@
 *
 ***********************************************************************/
 
-#include "LinkedList.h"
+#include "Command.h"
+#include "MoveLog.h"
+#include "Journal.h"
+#include "BoardPrinter.h"
+#include "Random.h"
 
 /* Default board size constants */
 #define DEFAULT_BOARD_n 3
 #define DEFAULT_BOARD_m 3
 
+/* number of workers that run the speculative solves of a game (outside of server mode) */
+#define SPECULATION_WORKERS 1
+
 /* max ILP generation attempts constant */
 #define MAX_GENERATES_ATTEMPTS 1000
 
+/* max number of puzzles of a single generate_batch command */
+#define MAX_BATCH_PUZZLES 10000000
+
+/* max solver commands time limit in milliseconds (a day) */
+#define MAX_TIME_LIMIT 86400000
+
+/*
+ * default max number of moves kept in the undo-redo moves log (0 for unlimited), see maxMoves in the Game struct.
+ * once the log is full, every new move drops the oldest one.
+ */
+#ifndef MAX_RETAINED_MOVES
+#define MAX_RETAINED_MOVES 0
+#endif
+
 /*
  * gameModeEnum represent the current gameMode of the user:
  * INIT_MODE, SOLVE_MODE, EDIT_MODE
@@ -92,14 +127,61 @@ typedef enum gameModeEnum {
  * 		c. entering solve or edit mode is via Solve or Edit command accordingly
  *
  * 6. moves:
- * 		a. a pointer to a doubly-linked list of the user's moves that maintains
- * 			 	a pointer to the current move.
- * 		b. the user may freely traverse this list (move current move pointer)
+ * 		a. a pointer to a log of the user's moves (MoveLog) that maintains
+ * 			 	the current move.
+ * 		b. the user may freely traverse this log (move current move pointer)
  * 		 		by using the redo / undo commands
+ * 		c. the log keeps at most maxMoves moves (if it isn't 0) - MAX_RETAINED_MOVES by default,
+ * 				or the -m option of the program (see GameFlow.h)
  *
  * 7. numOfNonZeroCells: count the number of non empty cells in game board
  *
  * 8. isErroneous: boolean equals 1 iff the board contains error
+ * 		numOfErroneousCells: the number of cells that are marked as erroneous
+ *
+ * 9. journal: the open session journal, or NULL if journaling is off.
+ * 		the journal holds the board as loaded by solve / edit,
+ * 		followed by every change to the moves log, so recover can rebuild the game.
+ *
+ * 10. printer: the board printer, which keeps the rendering buffers between prints.
+ *
+ * 11. quiet: 1 iff prompts and the automatic board prints after commands are suppressed
+ * 		(print_board still prints the board). The default value is 0.
+ *
+ * 12. protocolMode: 1 iff commands are answered with JSON lines (see Protocol.h),
+ * 		so print_board doesn't print the board. The default value is 0.
+ *
+ * 13. boardVersion: incremented on every change to the game board (and when a board is loaded or freed),
+ * 		so a background job result can be compared with the board it was computed on.
+ *
+ * 14. jobs: the background solver jobs (see BackgroundJobs.h), created by the first background command (NULL until then).
+ * 		solverPool: the server solver pool the session runs on (see Server.h), NULL outside of server mode.
+ * 		the background jobs of a server session run on it instead of workers of their own.
+ *
+ * 15. speculate: 1 iff the board is solved speculatively in the background after set, undo, redo and autofill,
+ * 		so validate, hint and save (in Edit mode) usually find the ILP result ready. The default value is 1.
+ * 		speculation: the single worker that runs the speculative solves (NULL until the first one).
+ * 		a server session has no worker of its own - its speculative solves run on the server solver pool.
+ * 		Only the solve of the current board version is kept - a new board change cancels the outdated solve,
+ * 		and the speculative results are never printed, so the command outputs are the same with and without it.
+ *
+ * 16. portfolio: 1 iff validate, hint and save (in Edit mode) solve the board with the portfolio solver
+ * 		(see Portfolio.h) instead of the ILP solver alone. The default value is 0.
+ *
+ * 17. random: the game random generator (see Random.h), used by generate.
+ * 		it is seeded once, when the game starts, from the clock or from the --seed option.
+ *
+ * 18. poolSize: number of pre-generated puzzles kept for each recent generate request (0 - no pool, the default).
+ * 		pool: the pre-generated puzzles pool (see PuzzlePool.h), created by the first generate (NULL until then).
+ *
+ * 19. timeLimit: the wall clock budget in milliseconds of every generate, generate_batch, validate, hint, num_solutions
+ * 		and save (in Edit mode) command, and of the background jobs, 0 for no limit (the default). See SolverDeadline in Solver.h.
+ *
+ * 20. generateStatsPath: the file the generate auto statistics are kept in (NULL - the statistics live only in the game).
+ * 		generateStats: the statistics generate auto chooses X by (see GenerateStats.h),
+ * 		loaded by the first generate auto (NULL until then).
+ * 		isGenerateStatsShared: 1 iff generateStats is the table of the server, shared by all the sessions
+ * 		(so the sessions don't overwrite each other's runs in the file), and isn't freed by the game.
  *
  */
 typedef struct Game{
@@ -138,14 +220,106 @@ typedef struct Game{
 
 
     /*
-     * A link list that holds all the operations for undo and redo
+     * A moves log that holds all the operations for undo and redo
      * */
-    LinkedList * moves;
+    MoveLog * moves;
 
     int numOfNonZeroCells;
 
     int isErroneous;
 
+    int numOfErroneousCells;
+
+    /*
+     * the session journal (NULL if journaling is off)
+     * */
+    Journal * journal;
+
+    /*
+     * the board printer (rendering buffers)
+     * */
+    BoardPrinter * printer;
+
+    /*
+     * 1 for suppressing prompts and automatic board prints, 0 otherwise
+     * */
+    int quiet;
+
+    /*
+     * 1 for protocol mode (JSON line replies), 0 otherwise
+     * */
+    int protocolMode;
+
+    /*
+     * the game board version (incremented on every board change)
+     * */
+    long boardVersion;
+
+    /*
+     * the background solver jobs (NULL if no job was started)
+     * */
+    struct BackgroundJobs * jobs;
+
+    /*
+     * the server solver pool (NULL outside of server mode)
+     * */
+    struct WorkerPool * solverPool;
+
+    /*
+     * 1 iff the board is solved speculatively after every change, 0 otherwise
+     * */
+    int speculate;
+
+    /*
+     * the speculative solves and their worker (NULL if no speculative solve was started)
+     * */
+    struct BackgroundJobs * speculation;
+
+    /*
+     * 1 for portfolio solving (ILP raced against backtracking), 0 for the ILP solver alone
+     * */
+    int portfolio;
+
+    /*
+     * the game random generator
+     * */
+    RandomGenerator random;
+
+    /*
+     * number of pre-generated puzzles per generate request (0 for no pool)
+     * */
+    int poolSize;
+
+    /*
+     * the pre-generated puzzles pool (NULL if no pool was created)
+     * */
+    struct PuzzlePool * pool;
+
+    /*
+     * the solver commands time limit in milliseconds (0 for no limit)
+     * */
+    long timeLimit;
+
+    /*
+     * the generate auto statistics file (NULL for none)
+     * */
+    char * generateStatsPath;
+
+    /*
+     * the generate auto statistics (NULL if generate auto wasn't used)
+     * */
+    struct GenerateStats * generateStats;
+
+    /*
+     * max number of moves kept in the moves log (0 for unlimited)
+     * */
+    int maxMoves;
+
+    /*
+     * 1 iff the generate auto statistics are shared with other games, 0 otherwise
+     * */
+    int isGenerateStatsShared;
+
 }Game;
 
 
@@ -153,8 +327,7 @@ typedef struct Game{
 /***** Initialization & Memory operation*****/
 
 /*
- * initialize moves linked list
- * with memory allocation and setting pointers to NULL
+ * initialize an empty moves log
  */
 void initMovesList(Game * game);
 
@@ -175,10 +348,11 @@ void freeGameBoards (Game * game);
  * 	2. game starts with mark errors default value - 1
  * 	3. game start with gameOver value set to 0
  * 	4. all game boards are initialized to NULL
- * 	NOTE: the value of mark_errors is changed to the default value
- * 	iff initializeMarkErrors == 1
+ * 	NOTE: the settings are initialized iff initializeSettings == 1:
+ * 		the value of mark_errors is changed to the default value, journaling is off,
+ * 		the board printer is created, quiet mode and protocol mode are off, and there are no background jobs
  */
-void initalizeGameAtINIT(Game* game, int initializeMarkErrors);
+void initalizeGameAtINIT(Game* game, int initializeSettings);
 
 
 
@@ -245,13 +419,15 @@ int checkAndMarkBoardErrorsInBlock(Game * game, int i, int j , int mark);
  * 		iii. update according to the uploaded board:
  * 				1. number of non empty cells
  * 				2. isErroneous value and mark cells with erroneous values as negatives
- * 		iv.  initialize a new "moves" LinkedList
+ * 		iv.  initialize a new "moves" log
  *
  * 	b. if the file doesn't exist or can't be opened -
  * 		i.  an error is printed and the command is not executed.
  *	c. print the board
- * 	d. NOTE:
- * 		i. 	we assume that the file contains valid data and is correctly formatted.
+ * 	d. the file may be a text board file or a binary board file (see BoardFile.h), detected automatically.
+ * 	   a binary board file is mapped to memory. if it doesn't describe a valid board - an error is printed and the command is not executed.
+ * 	e. NOTE:
+ * 		i. 	we assume that a text file contains valid data and is correctly formatted.
  * 		ii. Any unsaved work is lost.
  */
 void solve(Game * game, Command currCommand);
@@ -270,11 +446,12 @@ void solve(Game * game, Command currCommand);
  * 		ii.  update according to the uploaded board:
  * 				1. number of non empty cells
  * 				2. isErroneous value and mark cells with erroneous values as negatives
- * 		iii. initialize a new "moves" LinkedList
+ * 		iii. initialize a new "moves" log
  * 	d. print the board
  *
- *	e. NOTE:
- *		i.   We assume the file, if supplied, contains valid data and is correctly formatted.
+ *	e. the file may be a text board file or a binary board file (see BoardFile.h), detected automatically.
+ *	f. NOTE:
+ *		i.   We assume a text file, if supplied, contains valid data and is correctly formatted.
  *		ii.  in Edit mode, the value of the "mark errors" parameter is always considered to be 1,
  *			 ignoring its actual value.
  *		iii. Any unsaved work is lost.
@@ -288,6 +465,46 @@ void edit(Game * game, Command currCommand);
  */
 void markErrors(Game * game, Command currCommand);
 
+/*
+ *  gets the game and the parsed command:
+ *	a. Sets the board printing mode to X, where X is either 0 (scrolling output, the default) or 1 (tty mode).
+ *	   In tty mode the board stays at the top of the terminal, and each print only updates the cells
+ *	   that changed since the last print (see BoardPrinter.h).
+ *	b. If X is not 0 or 1, the program prints error and the command is not executed.
+ *	c. If X is 1 and the output isn't a terminal, the program prints error and the command is not executed.
+ */
+void ttyRender(Game * game, Command currCommand);
+
+/*
+ *	a. Sets the portfolio solving setting to X, where X is either 0 (the default) or 1.
+ *	   When it is 1, validate, hint and save (in Edit mode) race the ILP solver against the native backtracking solver
+ *	   in parallel, and take the first conclusive result (see Portfolio.h).
+ *	b. If X is not 0 or 1, the program prints error and the command is not executed.
+ */
+void portfolio(Game * game, Command currCommand);
+
+/*
+ *	a. Sets the time limit of the solver commands to X milliseconds, where X is 0 (no limit, the default) up to MAX_TIME_LIMIT.
+ *	   generate, generate_batch, validate, hint, num_solutions and save (in Edit mode) then stop once the time limit passed,
+ *	   print a timeout error and are not executed. generate also prints its number of attempts and the elapsed time,
+ *	   and generate_batch the number of puzzles it generated. A background job started with "&" gets the time limit
+ *	   set when it was started, counted from the moment a worker starts it, and reports the timeout as its result.
+ *	b. If X is not in range, the program prints error and the command is not executed.
+ */
+void timeLimit(Game * game, Command currCommand);
+
+/*
+ *  gets the game and the parsed command "view R C H W":
+ *	a. Sets the view to the rectangle of H rows and W columns whose top left cell is in row R and column C.
+ *	   print_board and the prints after commands then print only the view window -
+ *	   the rectangle extended to the blocks it touches - and a summary line (see printBoard).
+ *	b. If no params were supplied, the view is removed and the whole board is printed.
+ *	c. If R or C are not in the range 1-N, or H or W are not positive,
+ *	   the program prints error and the command is not executed.
+ *	d. The view is kept when another board is loaded (it is cut at the board end).
+ */
+void view(Game * game, Command currCommand);
+
 /*
  * The board will be printed in the following format:
  *	1. Separator row
@@ -303,6 +520,10 @@ void markErrors(Game * game, Command currCommand);
 * 	b. Two digits for the cell value (printf format "%2d"). blank cell  will have 2 spaces instead of a value.
 * 	c. A dot for a fixed cell, an asterisk for an erroneous cell when in Edit mode or the "Mark errors" parameter is set to 1,
 *  	   or space otherwise. Note that a fixed cell is never marked as erroneous
+*
+* The whole board is rendered into a reusable frame buffer and printed with a single write (see BoardPrinter.h).
+* If a view is set (see view), only the view window is printed, followed by a summary line:
+* the window rows and columns, the number of filled cells and the number of erroneous cells.
 */
 void printBoard(Game game);
 
@@ -331,11 +552,12 @@ void printBoard(Game game);
 void set(Game * game, Command currCommand);
 
 /*
- *	Validates the current board using ILP with solveBoardWithILP function,
+ *	Validates the current board using ILP with solveBoardWithILP function (Solver.h),
  *	ensuring it is solvable.
  *	1. If the board is erroneous, the program prints error and the command is not executed.
  *	2. If the board is found to be solvable, the program prints suitable message to user.
  *  	Otherwise, the program prints that the board is unsolvable.
+ *	NOTE: if the current board was already solved speculatively (see speculate in the Game struct) - the ILP isn't run again.
  */
 void validate(Game* game);
 
@@ -349,19 +571,41 @@ void validate(Game* game);
  *     a. Randomly choose X cells, filling each with a legal random value.
  *     b. Once X cells contain values, run ILP to solve the resulting board.
  *     c. After the board is solved - randomly choose Y cells, and clear the values of all other cells.
- *     d. i.   If one of the X randomly-chosen cells has no legal value available, or the resulting board has no solution (the ILP solver fails),
+ *     d. i.   If one of the X randomly-chosen cells has no legal value available, or the resulting board has no solution,
  *                 the board is entirely clear and we repeat steps a-c.
- *                 After 1000 such iterations, the program prints an error and the command is not executed.
+ *                 After 1000 such iterations (or if the ILP solver fails), the program prints an error and the command is not executed.
+ *                 The iterations run in parallel on a worker per processor (see PuzzleGenerator.h),
+ *                 or on the single solver pool worker the command runs on in a server session,
+ *                 and the puzzle of the first iteration (in order) that succeeded is kept.
+ *        iii. Boards with N >= PATTERN_GENERATE_MIN_N are too large for the ILP solver: their solution is built directly
+ *                 from a randomized pattern grid (X is ignored), and Y random cells of it are kept.
+ *        iv.  If the game has a puzzles pool (poolSize isn't 0), the puzzle is taken from the pool when it is ready there
+ *                 (see PuzzlePool.h), and it is recorded in the moves list like any generated puzzle.
  *        ii.  If the puzzle was generated successfully:
  *             - print the board
  *             - update isErroneous to 0 (false) and numOfNonZeroCells to Y
  *             - clear any move beyond the current move from the undo/redo list,
  *                 then add the new generate move to the end of the list and mark it as the current move.
+ * 4. If X is "auto", the program chooses X by the statistics of the previous generates of the board shape
+ *    (see GenerateStats.h) and prints it. Every generate with a candidate X adds its attempts, outcome and
+ *    elapsed time to the statistics, unless the puzzles pool is on (a pooled puzzle takes no generation time).
  *
  * NOTE: the function gets the user supplied X and Y values from currCommand
  */
 void generate(Game* game, Command currCommand);
 
+/*
+ * Generates COUNT puzzles of the current board dimensions, each like "generate X Y",
+ * and writes them to a puzzle pack file (see BoardFile.h) in FILE.
+ *
+ * 1. If COUNT isn't between 1 and MAX_BATCH_PUZZLES, or X or Y is invalid, the program prints an error and the command is not executed.
+ * 2. Otherwise, the puzzles are generated by several producer threads and streamed to the file (see PuzzleBatch.h),
+ *    and the program prints the progress and the throughput. The game board isn't changed.
+ *
+ * NOTE: the function gets the user supplied COUNT, X, Y and FILE values from currCommand
+ */
+void generateBatch(Game* game, Command currCommand);
+
 /*
  * Undo previous moves done by the user.
  *
@@ -405,6 +649,8 @@ void redo(Game * game);
  *         ii.  Each line contains a single row of the board.
  *         iii. Each cell contains the cell's value separated with single spaces. The value in empty cells is 0.
  *              if the cell is "fixed", follow its value with a dot '.'.
+ *    If the binary flag was supplied (currCommand.intArgs[0] == 1) the board is saved in the binary board file format instead (see BoardFile.h).
+ *    The file is replaced atomically: it either keeps its previous content or holds the whole new board.
  * e. NOTE:
  *     1. Saving the puzzle to a file does not modify the Redo/Undo list in any way, i.e., a reset command (described below) will still revert to the state of the originally loaded file.
  *     2. In Edit mode, all cells containing values are marked as "fixed".
@@ -420,7 +666,9 @@ void save(Game * game, Command currCommand);
  * 		3. cell <X,Y> is fixed
  * 		4. cell <X,Y> already contains a value
  *
- * Otherwise, Run ILP to solve the board using solveBoardWithILP function.
+ * Otherwise, the board is first solved with logic alone (see LogicSolver.h) - a board logic fills completely or finds
+ * a contradiction in needs no ILP. If logic gets stuck, Run ILP to solve the board using solveBoardWithILP function
+ * (unless the current board was already solved speculatively, see speculate in the Game struct).
  *      1. if the board is unsolvable -
  *         the program prints Error and the command is not executed.
  *		2. Otherwise, the program prints: "Hint: set cell to Z\n"
@@ -465,17 +713,102 @@ void numSolutions(Game * game);
  */
 void autofill(Game * game);
 
+/*
+ * Solve the board step by step with the logic techniques (see LogicSolver.h):
+ * singles, locked candidates, naked and hidden subsets and basic fish.
+ *
+ * 1. If the board is erroneous the program prints an error and the command is not executed.
+ * 2. Otherwise, the techniques run until the board is filled or none of them makes progress:
+ *     i.   the program prints the cell indexes and new value of every cell logic filled,
+ *          then every technique with the number of cells it filled, the number of candidates it removed
+ *          and the time spent in it, and then the number of cells filled and left empty.
+ *     ii.  the filled cells are a single move: any move beyond the current move is cleared from the undo/redo list,
+ *          then the new move is added to the end of the list and marked as the current move.
+ *     iii. the board is printed, and if it is entirely filled the program prints that the puzzle is solved
+ *          and the game mode is set to Init.
+ * 3. If logic finds a contradiction, the program prints that the board is unsolvable and the board isn't changed.
+ */
+void logicSolve(Game * game);
+
 /*
  * Undo all moves, reverting the board to its original loaded state.
  *
  * The command goes over the entire undo/redo list and reverts all moves (no output is provided).
+ * NOTE: if the moves log is limited (maxMoves), moves that were dropped from the log can't be reverted.
  * Once the board is reset, the undo/redo list is cleared entirely, and the program prints a suitable message.
 */
 void reset(Game * game);
 
 /*
  * Terminates the program by setting game->gameOver = 1.
+ * background jobs and the speculative solve are canceled (and their workers are stopped),
  * free all allocated memory resources, if exists,
  * and print Exiting message to the user
  */
 void exitGame(Game * game);
+
+/*
+ * Starts writing the session journal to the file "X" (or stops journaling if X isn't supplied).
+ *
+ * 1. any previous journal is closed.
+ * 2. if the file cannot be created or opened - the program prints error and journaling is off.
+ * 3. if a board is loaded (Edit or Solve mode) - the current board is written as the journal header.
+ *    otherwise, the header is written once a board is loaded by solve / edit.
+ * 4. from now on, every change to the moves log (set, generate, autofill, undo, redo, reset)
+ *    is appended to the journal.
+ */
+void journal(Game * game, Command currCommand);
+
+/*
+ * Rebuilds the game from the journal file "X":
+ * loads the journal header board in its game mode and replays the journal records
+ * into the board and the moves log, so undo and redo continue from where the session stopped.
+ *
+ * 1. if the file cannot be opened or isn't a valid journal - the program prints error and the command is not executed.
+ * 2. replay stops at the first incomplete or invalid record (e.g. a record the process died while writing).
+ * 3. journaling continues into the same file, after the last valid record.
+ * 4. print the board.
+ * NOTE: Any unsaved work is lost.
+ */
+void recover(Game * game, Command currCommand);
+
+/*
+ * writes the journal records of the last command to the journal file.
+ * if writing fails - the program prints error and journaling is off.
+ */
+void commitJournal(Game * game);
+
+/*
+ * Runs validate or num_solutions ("validate &", "num_solutions &") as a background job
+ * on a snapshot of the current board, and prints the job number.
+ *
+ * 1. If the board is erroneous, the program prints error and the job isn't started.
+ * 2. The game keeps executing commands while the job runs.
+ *    The job result is printed after the first command that ends once the job is done, like the
+ *    result of the command itself would be. If the board changed since the job started, the result is marked as stale.
+ */
+void runInBackground(Game * game, Command currCommand);
+
+/*
+ * Prints the background jobs that weren't reported yet: job number, state (queued, running or done) and command.
+ */
+void listJobs(Game * game);
+
+/*
+ * Waits until the background job X is done ("wait X"), or until all the background jobs are done ("wait"),
+ * and prints the results.
+ * If there is no background job X, the program prints error and the command is not executed.
+ */
+void waitJobs(Game * game, Command currCommand);
+
+/*
+ * Cancels the background job X ("cancel X"), its result is never printed.
+ * A running job is stopped.
+ * If there is no background job X, the program prints error and the command is not executed.
+ */
+void cancelJob(Game * game, Command currCommand);
+
+/*
+ * Prints the results of the background jobs that are done, and removes them from the jobs list.
+ */
+void reportFinishedJobs(Game * game);
@@ -2,15 +2,30 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 #include "Game.h"
+#include "WorkerPool.h"
+#include "GameFlow.h"
+#include "Protocol.h"
 #include "mainAux.h"
 
 /*
- * Execute the command according to its type
+ * SolverJob is a solver command sent to the solver pool:
+ * the pool job, the command, the session game and the session output context
+ */
+typedef struct SolverJob{
+	PoolJob job;
+	Command command;
+	Game * game;
+	OutputContext * context;
+}SolverJob;
+
+/*
+ * Run the command according to its type
  * checks is the command is available in the current game mode
  * and if it isn't - change the command type to INVALID so that the command is not executed
  */
-void executeCommand(Command currCommand, Game * game){
+void runCommand(Command currCommand, Game * game){
 
     switch (currCommand.type){
 
@@ -51,7 +66,10 @@ void executeCommand(Command currCommand, Game * game){
         		printInvalidCommandError();
         		return;
         	}
-            printBoard(*game);
+            /* in protocol mode the board is part of the command reply */
+            if (game->protocolMode == 0){
+            	printBoard(*game);
+            }
             break;
         }
 
@@ -77,6 +95,11 @@ void executeCommand(Command currCommand, Game * game){
 				printInvalidCommandError();
 				return;
 			}
+			/* "validate &" runs in the background */
+			if (currCommand.intArgs[0] == 1){
+				runInBackground(game, currCommand);
+				break;
+			}
             validate(game);
             break;
         }
@@ -155,6 +178,11 @@ void executeCommand(Command currCommand, Game * game){
 				printInvalidCommandError();
 				return;
 			}
+			/* "num_solutions &" runs in the background */
+			if (currCommand.intArgs[0] == 1){
+				runInBackground(game, currCommand);
+				break;
+			}
             numSolutions(game);
             break;
         }
@@ -189,6 +217,95 @@ void executeCommand(Command currCommand, Game * game){
         	break;
         }
 
+        case JOURNAL:{
+        	journal(game, currCommand);
+        	if(currCommand.filePath != NULL){
+        		free(currCommand.filePath);
+        	}
+        	break;
+        }
+
+        case RECOVER:{
+        	recover(game, currCommand);
+        	free(currCommand.filePath);
+        	break;
+        }
+
+        case TTY_RENDER:{
+        	/* tty_render is available in all modes */
+        	ttyRender(game, currCommand);
+        	break;
+        }
+
+        case VIEW:{
+        	/*
+        	 * view is only available in Edit and Solve modes.
+        	 * Otherwise, treat it as an invalid command.
+        	 */
+        	if (game->gameMode != SOLVE_MODE && game->gameMode != EDIT_MODE ){
+        		printInvalidCommandError();
+        		return;
+        	}
+        	view(game, currCommand);
+        	break;
+        }
+
+        case JOBS:{
+        	/* jobs, wait and cancel are available in all modes */
+        	listJobs(game);
+        	break;
+        }
+
+        case WAIT:{
+        	waitJobs(game, currCommand);
+        	break;
+        }
+
+        case CANCEL:{
+        	cancelJob(game, currCommand);
+        	break;
+        }
+
+        case PORTFOLIO:{
+        	/* portfolio is available in all modes */
+        	portfolio(game, currCommand);
+        	break;
+        }
+
+        case GENERATE_BATCH:{
+        	/*
+        	 *  Generate_batch command is only available in Edit mode.
+			 *	Otherwise, treat it as an invalid command.
+			 */
+			if (game->gameMode != EDIT_MODE){
+				printInvalidCommandError();
+				free(currCommand.filePath);
+				return;
+			}
+			generateBatch(game, currCommand);
+			free(currCommand.filePath);
+            break;
+        }
+
+        case TIME_LIMIT:{
+        	/* time_limit is available in all modes */
+        	timeLimit(game, currCommand);
+        	break;
+        }
+
+        case LOGIC_SOLVE:{
+        	/*
+        	 * logic_solve is only available in Solve mode.
+        	 * Otherwise, treat it as an invalid command.
+        	 */
+        	if (game->gameMode != SOLVE_MODE){
+        		printInvalidCommandError();
+        		return;
+        	}
+        	logicSolve(game);
+        	break;
+        }
+
         case INVALID:{
             printInvalidCommandError();
             break;
@@ -201,55 +318,144 @@ void executeCommand(Command currCommand, Game * game){
 }
 
 
-void runGame(){
+/*
+ * run a solver job on a pool worker, printing to the output context of the session that sent it
+ */
+void runSolverJob(void * arg){
+	SolverJob * solverJob = (SolverJob *) arg;
+
+	setOutputContext(solverJob->context);
+	runCommand(solverJob->command, solverJob->game);
+	setOutputContext(NULL);
+}
+
+/*
+ * return 1 iff the command may run the ILP solver or the exhaustive backtracking solver
+ */
+int isSolverCommand(Command currCommand){
+	/* background commands only start a job */
+	if ((currCommand.type == VALIDATE || currCommand.type == NUM_SOLUTIONS) && currCommand.intArgs[0] == 1){
+		return 0;
+	}
+	return currCommand.type == VALIDATE || currCommand.type == GENERATE || currCommand.type == HINT ||
+			currCommand.type == NUM_SOLUTIONS || currCommand.type == SAVE || currCommand.type == GENERATE_BATCH;
+}
+
+/*
+ * Execute the command:
+ * solver commands are run on the solver pool (if there is one) while the session waits for them,
+ * all other commands are run in the session thread
+ */
+void executeCommand(Command currCommand, Game * game, WorkerPool * solverPool){
+	SolverJob solverJob;
+
+	if (solverPool == NULL || isSolverCommand(currCommand) == 0){
+		runCommand(currCommand, game);
+		return;
+	}
+	solverJob.command = currCommand;
+	solverJob.game = game;
+	solverJob.context = getOutputContext();
+	runPoolJob(solverPool, &solverJob.job, runSolverJob, &solverJob);
+}
+
+
+int runGame(FILE * commandsFile, GameOptions * options, WorkerPool * solverPool){
 
 	Game game;
 	/* buffer for user input */
 	char * input;
 	/* current command Command Struct */
 	Command currCommand;
+	/* protocol mode state (a JSON reply line per command) */
+	Protocol protocol;
 
-	/* Initialize new game */
+	/* Initialize new game, protocol mode is always quiet */
 	initalizeGameAtINIT(&game, 1);
+	game.quiet = options->quiet == 1 || options->protocolMode == 1;
+	game.protocolMode = options->protocolMode;
+	game.speculate = options->speculate;
+	game.solverPool = solverPool;
+	game.poolSize = options->poolSize;
+	game.generateStatsPath = options->generateStatsPath;
+	game.generateStats = options->generateStats;
+	game.isGenerateStatsShared = options->generateStats != NULL;
+	/* the moves log of the new game is started over with the moves limit */
+	if (options->maxMoves > 0){
+		game.maxMoves = options->maxMoves;
+		freeMoveLog(game.moves);
+		initMovesList(&game);
+	}
+	if (options->hasSeed == 1){
+		seedRandom(&game.random, options->seed);
+	}
+	if (game.protocolMode == 1){
+		initProtocol(&protocol);
+	}
 
     /* print the opening string */
-	printStartSudokuString();
+	if (game.quiet == 0){
+		printStartSudokuString();
+	}
 
     while(game.gameOver == 0){
 
-    	/* get command input from the user */
-    	printEnterCommand();
+    	/* get command input from the user (no prompt in quiet mode) */
+    	if (game.quiet == 0){
+    		printEnterCommand();
+    	}
+    	/* the output may be a socket or a pipe, the client sees it before the next command is read */
+    	fflush(getOutput());
         /*get command line from user
          * in case of a problem - print error and exit
          * Note: no need to exit cleanly
          */
-    	input = getLine(stdin);
+    	input = getLine(commandsFile);
+    	if (game.protocolMode == 1){
+    		beginProtocolCommand(&protocol, input);
+    	}
     	/*
     	 * if NULL was returned then we reached EOF
     	 * this is treated as an exit command
     	 */
     	if(input == NULL) {
     		currCommand.type = EXIT;
-    		executeCommand(currCommand, &game);
-    		continue;
     	}
     	/* if the command length exceed COMMAND_MAX_SIZE chars
     	 * treat it as invalid command
     	 */
-    	if (strlen(input) > COMMAND_MAX_SIZE){
-    		printInvalidCommandError();
-    		free(input);
-    		continue;
+    	else if (strlen(input) > COMMAND_MAX_SIZE){
+    		currCommand.type = INVALID;
     	}
-
     	/* parse the user current command to the defined format - Command struct */
-        currCommand = parseCommand(input);
+    	else {
+    		currCommand = parseCommand(input);
+    	}
         free(input);
 
         /* execute the parsed command by its type */
-        executeCommand(currCommand, &game);
+        executeCommand(currCommand, &game, solverPool);
+
+        /* print the results of the background jobs that are done by now */
+        reportFinishedJobs(&game);
 
+        /* write the command journal records (if journaling is on) */
+        commitJournal(&game);
+
+        /* reply to the command (blank lines aren't commands) */
+        if (game.protocolMode == 1 && currCommand.type != IGNORE){
+        	endProtocolCommand(&protocol, &game, currCommand.type == PRINT_BOARD);
+        }
     }
 
+    if (game.protocolMode == 1){
+    	freeProtocol(&protocol);
+    }
+
+    /* the command failed iff it printed an error message */
+    if (getNumOfPrintedErrors() > 0){
+    	return EXIT_STATUS_COMMAND_FAILED;
+    }
+    return EXIT_STATUS_SUCCESS;
 }
 
@@ -6,19 +6,75 @@
 *       get user commands, send them to the parser and check their availability, as well as sending each command to execution with the desired parameters.
 *
 * PUBLIC FUNCTIONS :
-*       void runGame()
+*       int runGame(FILE * commandsFile, GameOptions * options, WorkerPool * solverPool)
 
 * NOTES :
 *       1. runGame function loop is executed while the game is not over
-*       2. runGame use the internal function, executeCommand in order to check the requested command availability in the current game mode.
-*          if the requested command is indeed available - executeCommand call the suitable function from Game.h with the desired parameters.
+*       2. runGame use the internal function, runCommand (through executeCommand) in order to check the requested command availability in the current game mode.
+*          if the requested command is indeed available - runCommand call the suitable function from Game.h with the desired parameters.
+*       3. commands are read from the standard input, or from a commands file in batch mode (main options, see below).
+*          in quiet mode the prompts and the automatic board prints after commands are suppressed.
+*       4. in protocol mode (always quiet) every command gets a single JSON reply line instead of its messages (see Protocol.h).
+*       5. runGame prints through the output context of the calling thread (see mainAux.h), so several games
+*          can run at once in different threads (server mode, see Server.h).
+*          solver commands (validate, generate, hint, num_solutions and save) may be run on a shared solver pool.
+*       6. validate and num_solutions followed by "&" run as background jobs of the game (see BackgroundJobs.h),
+*          and the results of the jobs that finished are printed after each command.
+*       7. The files that include GameFlow.h must include pthread.h and WorkerPool.h before it.
 *
 ***********************************************************************/
 
+/* command line options */
+#define QUIET_OPTION "-q"
+#define COMMANDS_FILE_OPTION "-f"
+#define PROTOCOL_OPTION "-j"
+#define SERVER_OPTION "-s"
+#define CLIENT_OPTION "-c"
+#define WORKERS_OPTION "-w"
+#define NO_SPECULATION_OPTION "-n"
+#define SEED_OPTION "--seed"
+#define POOL_OPTION "-p"
+#define GENERATE_STATS_OPTION "-g"
+#define MAX_MOVES_OPTION "-m"
+
+/* program exit status */
+#define EXIT_STATUS_SUCCESS 0
+#define EXIT_STATUS_COMMAND_FAILED 1
+#define EXIT_STATUS_USAGE_ERROR 2
+
+/*
+ * GameOptions are the game options given in the command line:
+ * 1. quiet - 1 iff prompts and automatic board prints are suppressed
+ * 2. protocolMode - 1 iff every command is answered with a JSON line (see Protocol.h)
+ * 3. speculate - 0 iff the board isn't solved speculatively in the background after every change (see Game.h)
+ * 4. hasSeed, seed - if hasSeed is 1 the game random generator is seeded with seed,
+ * 		otherwise it is seeded from the clock (see Random.h)
+ * 5. poolSize - number of pre-generated puzzles kept for each recent generate request, 0 for no pool (see PuzzlePool.h)
+ * 6. generateStatsPath - the file the statistics of generate auto are kept in, NULL for none (see GenerateStats.h)
+ * 7. generateStats - the generate auto statistics shared by all the games (the sessions of a server, see Server.h),
+ * 		NULL - every game loads its own statistics from generateStatsPath
+ * 8. maxMoves - max number of moves kept in the undo-redo moves log, 0 for the default (MAX_RETAINED_MOVES, see Game.h)
+ */
+typedef struct GameOptions{
+	int quiet;
+	int protocolMode;
+	int speculate;
+	int hasSeed;
+	unsigned long seed;
+	int poolSize;
+	char * generateStatsPath;
+	struct GenerateStats * generateStats;
+	int maxMoves;
+}GameOptions;
+
 /*
- * Initialize a new game parameters and starts the game loop
+ * Initialize a new game parameters and starts the game loop:
+ * commands are read from commandsFile until an exit command (or the end of the file).
+ * the game is set up by options (see GameOptions above).
+ * if solverPool isn't NULL - solver commands are run on one of its workers, otherwise in the calling thread.
+ * returns the program exit status - EXIT_STATUS_SUCCESS if no command failed, otherwise EXIT_STATUS_COMMAND_FAILED
  */
-void runGame();
+int runGame(FILE * commandsFile, GameOptions * options, WorkerPool * solverPool);
 
 
 
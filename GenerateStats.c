@@ -0,0 +1,280 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "GenerateStats.h"
+#include "BoardFile.h"
+#include "mainAux.h"
+
+/***** GenerateStats inner functions *****/
+
+/*
+ * returns candidate number k of the seed counts of N*N board (see the notes in GenerateStats.h)
+ */
+int getSeedCountCandidate(int N, int k) {
+	int minX = N;
+	int maxX = N*N/2;
+
+	if (maxX < minX) {
+		maxX = minX;
+	}
+	return minX + (int) ((long) k*(maxX - minX) / (GENERATE_AUTO_CANDIDATES - 1));
+}
+
+/*
+ * returns 1 iff x is one of the candidate seed counts of N*N board
+ */
+int isSeedCountCandidate(int N, int x) {
+	int k;
+
+	for (k = 0; k < GENERATE_AUTO_CANDIDATES; k++) {
+		if (getSeedCountCandidate(N, k) == x) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * returns 1 iff candidate k of the board shape has the same seed count as the one before it
+ * (on small boards the candidates aren't all different, and only the first of the equal candidates is used)
+ */
+int isDuplicateCandidate(ShapeStats * shape, int k) {
+	return k > 0 && shape->candidates[k].x == shape->candidates[k-1].x;
+}
+
+/*
+ * returns the statistics of the board shape m, n, or NULL if the table doesn't have them
+ */
+ShapeStats * findShapeStats(GenerateStats * stats, int m, int n) {
+	int s;
+
+	for (s = 0; s < stats->numOfShapes; s++) {
+		if (stats->shapes[s].m == m && stats->shapes[s].n == n) {
+			return &stats->shapes[s];
+		}
+	}
+	return NULL;
+}
+
+/*
+ * returns the total number of generates of the board shape
+ */
+long getShapeRuns(ShapeStats * shape) {
+	long runs = 0;
+	int k;
+
+	for (k = 0; k < GENERATE_AUTO_CANDIDATES; k++) {
+		runs += shape->candidates[k].runs;
+	}
+	return runs;
+}
+
+/*
+ * returns the statistics of the board shape m, n, adding empty statistics for it if the table doesn't have them
+ * (when the table is full, they replace the shape with the fewest generates)
+ */
+ShapeStats * getShapeStats(GenerateStats * stats, int m, int n) {
+	ShapeStats * shape = findShapeStats(stats, m, n);
+	int s;
+	int k;
+
+	if (shape != NULL) {
+		return shape;
+	}
+	if (stats->numOfShapes < GENERATE_STATS_MAX_SHAPES) {
+		shape = &stats->shapes[stats->numOfShapes++];
+	}
+	else {
+		shape = &stats->shapes[0];
+		for (s = 1; s < GENERATE_STATS_MAX_SHAPES; s++) {
+			if (getShapeRuns(&stats->shapes[s]) < getShapeRuns(shape)) {
+				shape = &stats->shapes[s];
+			}
+		}
+	}
+	shape->m = m;
+	shape->n = n;
+	for (k = 0; k < GENERATE_AUTO_CANDIDATES; k++) {
+		shape->candidates[k].x = getSeedCountCandidate(m*n, k);
+		shape->candidates[k].runs = 0;
+		shape->candidates[k].successes = 0;
+		shape->candidates[k].attempts = 0;
+		shape->candidates[k].seconds = 0;
+	}
+	return shape;
+}
+
+/*
+ * returns the statistics of seed count x in the board shape, or NULL if x isn't a candidate
+ */
+SeedCountStats * findSeedCountStats(ShapeStats * shape, int x) {
+	int k;
+
+	for (k = 0; k < GENERATE_AUTO_CANDIDATES; k++) {
+		if (shape->candidates[k].x == x) {
+			return &shape->candidates[k];
+		}
+	}
+	return NULL;
+}
+
+/*
+ * reads the table from the open file fp (see the notes in GenerateStats.h), stopping at the first invalid line
+ */
+void readGenerateStats(GenerateStats * stats, FILE * fp) {
+	char magic[5];
+	int version;
+	SeedCountStats line;
+	SeedCountStats * candidate;
+	int m;
+	int n;
+
+	if (fscanf(fp, "%4s %d", magic, &version) != 2 ||
+			strcmp(magic, GENERATE_STATS_MAGIC) != 0 || version != GENERATE_STATS_VERSION) {
+		return;
+	}
+	while (fscanf(fp, "%d %d %d %ld %ld %ld %lf", &m, &n, &line.x, &line.runs, &line.successes,
+			&line.attempts, &line.seconds) == 7) {
+		if (m <= 0 || n <= 0 || line.runs < 0 || line.successes < 0 || line.successes > line.runs ||
+				line.attempts < 0 || line.seconds < 0) {
+			return;
+		}
+		candidate = findSeedCountStats(getShapeStats(stats, m, n), line.x);
+		if (candidate != NULL) {
+			*candidate = line;
+		}
+	}
+}
+
+/*
+ * replaces the table file with the table. returns 1 iff it was saved
+ */
+int saveGenerateStats(GenerateStats * stats) {
+	char * data;
+	long len;
+	int saved;
+	int s;
+	int k;
+	SeedCountStats * candidate;
+
+	data = (char *) malloc(GENERATE_STATS_LINE_MAX_SIZE *
+			((long) stats->numOfShapes*GENERATE_AUTO_CANDIDATES + 1));
+	if (data == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	len = sprintf(data, "%s %d\n", GENERATE_STATS_MAGIC, GENERATE_STATS_VERSION);
+	for (s = 0; s < stats->numOfShapes; s++) {
+		for (k = 0; k < GENERATE_AUTO_CANDIDATES; k++) {
+			if (isDuplicateCandidate(&stats->shapes[s], k)) {
+				continue;
+			}
+			candidate = &stats->shapes[s].candidates[k];
+			len += sprintf(data + len, "%d %d %d %ld %ld %ld %.6f\n", stats->shapes[s].m, stats->shapes[s].n,
+					candidate->x, candidate->runs, candidate->successes, candidate->attempts, candidate->seconds);
+		}
+	}
+	saved = replaceFileAtomically(stats->path, data, len);
+	free(data);
+	return saved;
+}
+
+
+/***** GenerateStats.h implementation *****/
+
+GenerateStats * loadGenerateStats(char * path){
+	GenerateStats * stats;
+	FILE * fp;
+
+	stats = (GenerateStats *) malloc(sizeof(GenerateStats));
+	if (stats == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	stats->numOfShapes = 0;
+	stats->path = NULL;
+	pthread_mutex_init(&stats->lock, NULL);
+	if (path == NULL){
+		return stats;
+	}
+
+	stats->path = (char *) malloc(strlen(path) + 1);
+	if (stats->path == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	strcpy(stats->path, path);
+	fp = fopen(path, "r");
+	if (fp != NULL){
+		readGenerateStats(stats, fp);
+		fclose(fp);
+	}
+	return stats;
+}
+
+void freeGenerateStats(GenerateStats * stats){
+	if (stats == NULL){
+		return;
+	}
+	pthread_mutex_destroy(&stats->lock);
+	free(stats->path);
+	free(stats);
+}
+
+int chooseGenerateSeedCount(GenerateStats * stats, int m, int n){
+	ShapeStats * shape;
+	SeedCountStats * candidate;
+	int best = -1;
+	int x;
+	int k;
+
+	pthread_mutex_lock(&stats->lock);
+	shape = findShapeStats(stats, m, n);
+	if (shape == NULL){
+		pthread_mutex_unlock(&stats->lock);
+		return getSeedCountCandidate(m*n, 0);
+	}
+	for (k = 0; k < GENERATE_AUTO_CANDIDATES; k++){
+		candidate = &shape->candidates[k];
+		if (isDuplicateCandidate(shape, k)){
+			continue;
+		}
+		if (candidate->runs < GENERATE_AUTO_MIN_RUNS){
+			pthread_mutex_unlock(&stats->lock);
+			return candidate->x;
+		}
+		/* expected seconds to a generated puzzle: seconds / successes (a candidate that never succeeded is last) */
+		if (candidate->successes > 0 && (best == -1 ||
+				candidate->seconds * shape->candidates[best].successes <
+				shape->candidates[best].seconds * candidate->successes)){
+			best = k;
+		}
+	}
+	x = shape->candidates[best == -1 ? 0 : best].x;
+	pthread_mutex_unlock(&stats->lock);
+	return x;
+}
+
+int recordGenerateRun(GenerateStats * stats, int m, int n, int x, int numOfAttempts, int succeeded, double seconds){
+	SeedCountStats * candidate;
+	int saved = 1;
+
+	if (isSeedCountCandidate(m*n, x) == 0){
+		return 1;
+	}
+	/* the file is saved under the lock, so a later save never writes an older table */
+	pthread_mutex_lock(&stats->lock);
+	candidate = findSeedCountStats(getShapeStats(stats, m, n), x);
+	candidate->runs++;
+	candidate->successes += succeeded;
+	candidate->attempts += numOfAttempts;
+	candidate->seconds += seconds;
+	if (stats->path != NULL){
+		saved = saveGenerateStats(stats);
+	}
+	pthread_mutex_unlock(&stats->lock);
+	return saved;
+}
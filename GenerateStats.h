@@ -0,0 +1,110 @@
+/************************************
+* FILES NAMES :        GenerateStats.c , GenerateStats.h
+*
+* DESCRIPTION :
+*       The generate statistics table behind "generate auto Y": for every board shape (block dimensions m, n),
+*       the outcomes and timings of past generates with each of a few candidate seed counts (X values),
+*       and the choice of the seed count with the lowest expected time to a generated puzzle.
+*
+* PUBLIC FUNCTIONS :
+*       GenerateStats * loadGenerateStats(char * path)
+*       void freeGenerateStats(GenerateStats * stats)
+*       int chooseGenerateSeedCount(GenerateStats * stats, int m, int n)
+*       int recordGenerateRun(GenerateStats * stats, int m, int n, int x, int numOfAttempts, int succeeded, double seconds)
+*
+* NOTES :
+*       1. The candidate seed counts of N*N board are GENERATE_AUTO_CANDIDATES values spread evenly from N
+*          (enough random cells to make the solution random) to N*N/2 (beyond it almost every attempt dead-ends).
+*       2. Every generate adds its number of attempts, whether it succeeded and its elapsed seconds to its candidate.
+*          The expected time to a generated puzzle with a candidate is its total seconds divided by its successes.
+*          Each candidate is tried GENERATE_AUTO_MIN_RUNS times (in order, from the lowest seed count)
+*          before the candidate with the lowest expected time is chosen.
+*          Y isn't part of the key: it only chooses the cells that are kept after the board was solved,
+*          so it doesn't change the cost of the attempts.
+*       3. The table is kept in a small text file, which is read once and replaced atomically (see BoardFile.h)
+*          after every recorded generate: a "SDKS 1" header line, then a line per candidate -
+*          m, n, X, number of generates, number of successes, number of attempts and total seconds.
+*          A missing file is an empty table, and the lines of unknown candidates are ignored.
+*       4. The table keeps up to GENERATE_STATS_MAX_SHAPES board shapes, a new shape replaces the one with the fewest generates.
+*       5. A table may be shared by games in several threads (the sessions of a server, see Server.h): choosing and recording
+*          take the table lock, and the file is replaced under it, so the saves are in order and the file holds every run.
+*       6. The files that include GenerateStats.h must include pthread.h before it.
+*
+************************************/
+
+/* generate stats file format constants */
+#define GENERATE_STATS_MAGIC "SDKS"
+#define GENERATE_STATS_VERSION 1
+#define GENERATE_STATS_LINE_MAX_SIZE 128
+
+/* number of board shapes the table keeps */
+#define GENERATE_STATS_MAX_SHAPES 16
+
+/* number of candidate seed counts per board shape */
+#define GENERATE_AUTO_CANDIDATES 8
+
+/* number of generates with each candidate before the seed count is chosen by the expected time */
+#define GENERATE_AUTO_MIN_RUNS 2
+
+/*
+ * SeedCountStats are the statistics of a single candidate seed count:
+ * 1. x - the seed count
+ * 2. runs, successes - the number of generates with the seed count, and how many of them generated a puzzle
+ * 3. attempts - the total number of attempts of the generates
+ * 4. seconds - the total elapsed seconds of the generates
+ */
+typedef struct SeedCountStats{
+	int x;
+	long runs;
+	long successes;
+	long attempts;
+	double seconds;
+}SeedCountStats;
+
+/*
+ * ShapeStats are the statistics of a single board shape:
+ * 1. m, n - the block dimensions
+ * 2. candidates - the statistics of each candidate seed count, in increasing order of the seed counts
+ */
+typedef struct ShapeStats{
+	int m;
+	int n;
+	SeedCountStats candidates[GENERATE_AUTO_CANDIDATES];
+}ShapeStats;
+
+/*
+ * GenerateStats struct contains:
+ * 1. path - the file the table is kept in (owned by the table), NULL if it isn't kept in a file
+ * 2. lock - protects the shapes statistics and the file saves
+ * 3. shapes, numOfShapes - the board shapes statistics
+ */
+typedef struct GenerateStats{
+	char * path;
+	pthread_mutex_t lock;
+	ShapeStats shapes[GENERATE_STATS_MAX_SHAPES];
+	int numOfShapes;
+}GenerateStats;
+
+/*
+ * allocates a generate stats table and reads it from the file in path (if path isn't NULL and the file exists),
+ * so the table is kept in that file. path may be NULL - then the table only lives in memory
+ */
+GenerateStats * loadGenerateStats(char * path);
+
+/*
+ * frees the table. if stats is NULL the function doesn't perform any operation
+ */
+void freeGenerateStats(GenerateStats * stats);
+
+/*
+ * returns the seed count (X) that generate should use on a board with block dimensions m, n (see the notes above)
+ */
+int chooseGenerateSeedCount(GenerateStats * stats, int m, int n);
+
+/*
+ * adds a generate with seed count x on a board with block dimensions m, n to the table:
+ * its number of attempts, succeeded - 1 iff a puzzle was generated, and its elapsed seconds.
+ * a seed count that isn't a candidate of the board shape is ignored.
+ * the table file is then replaced, and the function returns 1 iff it was saved (or there is no file)
+ */
+int recordGenerateRun(GenerateStats * stats, int m, int n, int x, int numOfAttempts, int succeeded, double seconds);
@@ -0,0 +1,229 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include "Journal.h"
+#include "BoardFile.h"
+#include "mainAux.h"
+
+/***** Journal inner functions *****/
+
+/* read 2 bytes little endian from buf (as signed) */
+int getJournalSigned16(unsigned char * buf) {
+	int x = getUint16(buf);
+	if(x >= 0x8000) {
+		x -= 0x10000;
+	}
+	return x;
+}
+
+/*
+ * return the check byte of a record:
+ * xor of all the other record bytes and a constant,
+ * so an all zero (never written) record is never valid
+ */
+unsigned char getRecordCheck(unsigned char * record) {
+	int k;
+	unsigned char check = 0xA5;
+
+	check ^= record[0];
+	for(k = 2; k < JOURNAL_RECORD_SIZE; k++) {
+		check ^= record[k];
+	}
+	return check;
+}
+
+
+/***** Journal.h implementation *****/
+
+Journal * openJournal(char * path, long validLength) {
+	Journal * journal;
+	int fd;
+
+	if(validLength < 0) {
+		fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	}
+	else {
+		fd = open(path, O_WRONLY);
+	}
+	if(fd < 0) {
+		return NULL;
+	}
+
+	/* drop a partially written record (if any) and append after the last valid one */
+	if(validLength >= 0 &&
+			(ftruncate(fd, validLength) != 0 || lseek(fd, validLength, SEEK_SET) < 0)) {
+		close(fd);
+		return NULL;
+	}
+
+	journal = (Journal *) malloc(sizeof(Journal));
+	if (journal == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	journal->fd = fd;
+	journal->bufferLen = 0;
+	journal->recordsSinceSync = 0;
+	return journal;
+}
+
+int closeJournal(Journal * journal) {
+	int success;
+
+	if(journal == NULL) {
+		return 1;
+	}
+	success = journalCommit(journal);
+	if(fsync(journal->fd) != 0) {
+		success = 0;
+	}
+	if(close(journal->fd) != 0) {
+		success = 0;
+	}
+	free(journal);
+	return success;
+}
+
+int journalWriteHeader(Journal * journal, int mode, int m, int n, int ** board, int ** fixedBoard) {
+	int i;
+	int j;
+	int cell;
+	int N = m*n;
+	long len = JOURNAL_HEADER_SIZE + (long) N*N*JOURNAL_CELL_SIZE;
+	unsigned char * header;
+	unsigned char * cursor;
+	int success;
+
+	if(N > JOURNAL_MAX_N) {
+		return 0;
+	}
+	header = (unsigned char *) malloc(len);
+	if (header == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+
+	memcpy(header, JOURNAL_MAGIC, 4);
+	header[4] = JOURNAL_VERSION;
+	header[5] = (unsigned char) mode;
+	putUint16(header + 6, m);
+	putUint16(header + 8, n);
+
+	cursor = header + JOURNAL_HEADER_SIZE;
+	for(i = 0; i < N; i++) {
+		for(j = 0; j < N; j++) {
+			cell = abs(board[i][j]);
+			if(fixedBoard[i][j] != 0) {
+				cell |= JOURNAL_FIXED_CELL_BIT;
+			}
+			putUint16(cursor, cell);
+			cursor += JOURNAL_CELL_SIZE;
+		}
+	}
+
+	/* the previous session records are dropped with the file content */
+	journal->bufferLen = 0;
+	success = ftruncate(journal->fd, 0) == 0 &&
+			lseek(journal->fd, 0, SEEK_SET) == 0 &&
+			writeAll(journal->fd, header, len) &&
+			fsync(journal->fd) == 0;
+	journal->recordsSinceSync = 0;
+
+	free(header);
+	return success;
+}
+
+int journalAppend(Journal * journal, int type, int row, int col, int value, int oldValue) {
+	unsigned char * record;
+
+	if(journal->bufferLen + JOURNAL_RECORD_SIZE > JOURNAL_BUFFER_SIZE) {
+		if(writeAll(journal->fd, journal->buffer, journal->bufferLen) == 0) {
+			return 0;
+		}
+		journal->bufferLen = 0;
+	}
+
+	record = journal->buffer + journal->bufferLen;
+	record[0] = (unsigned char) type;
+	putUint16(record + 2, row);
+	putUint16(record + 4, col);
+	putUint16(record + 6, value);
+	putUint16(record + 8, oldValue);
+	record[1] = getRecordCheck(record);
+
+	journal->bufferLen += JOURNAL_RECORD_SIZE;
+	journal->recordsSinceSync++;
+	return 1;
+}
+
+int journalCommit(Journal * journal) {
+	if(journal->bufferLen > 0) {
+		if(writeAll(journal->fd, journal->buffer, journal->bufferLen) == 0) {
+			return 0;
+		}
+		journal->bufferLen = 0;
+	}
+
+	if(journal->recordsSinceSync >= JOURNAL_SYNC_GROUP) {
+		if(fsync(journal->fd) != 0) {
+			return 0;
+		}
+		journal->recordsSinceSync = 0;
+	}
+	return 1;
+}
+
+int readJournalHeader(FILE * fp, int * mode, int * m, int * n) {
+	unsigned char header[JOURNAL_HEADER_SIZE];
+
+	if(fread(header, 1, JOURNAL_HEADER_SIZE, fp) != JOURNAL_HEADER_SIZE ||
+			memcmp(header, JOURNAL_MAGIC, 4) != 0 ||
+			header[4] != JOURNAL_VERSION) {
+		return 0;
+	}
+	*mode = header[5];
+	*m = getUint16(header + 6);
+	*n = getUint16(header + 8);
+	/* m*n is checked before the caller allocates the boards */
+	if(*m <= 0 || *n <= 0 || *m > JOURNAL_MAX_N / *n) {
+		return 0;
+	}
+	return 1;
+}
+
+int readJournalCell(FILE * fp, int * value, int * isFixed) {
+	unsigned char cell[JOURNAL_CELL_SIZE];
+
+	if(fread(cell, 1, JOURNAL_CELL_SIZE, fp) != JOURNAL_CELL_SIZE) {
+		return 0;
+	}
+	*value = getUint16(cell) & ~JOURNAL_FIXED_CELL_BIT;
+	*isFixed = (getUint16(cell) & JOURNAL_FIXED_CELL_BIT) != 0;
+	return 1;
+}
+
+int readJournalRecord(FILE * fp, JournalRecord * record) {
+	unsigned char buf[JOURNAL_RECORD_SIZE];
+
+	if(fread(buf, 1, JOURNAL_RECORD_SIZE, fp) != JOURNAL_RECORD_SIZE ||
+			buf[1] != getRecordCheck(buf) ||
+			buf[0] < JOURNAL_BEGIN_MOVE || buf[0] > JOURNAL_RESET) {
+		return 0;
+	}
+	record->type = buf[0];
+	record->row = getUint16(buf + 2);
+	record->col = getUint16(buf + 4);
+	record->value = getJournalSigned16(buf + 6);
+	record->oldValue = getJournalSigned16(buf + 8);
+	return 1;
+}
+
+long getJournalLength(int N, int numOfRecords) {
+	return JOURNAL_HEADER_SIZE + (long) N*N*JOURNAL_CELL_SIZE +
+			(long) numOfRecords*JOURNAL_RECORD_SIZE;
+}
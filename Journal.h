@@ -0,0 +1,146 @@
+/************************************
+* FILES NAMES :        Journal.c , Journal.h
+*
+* DESCRIPTION :
+*       Crash-safe append-only session journal.
+*       The journal file holds the loaded board (header) followed by fixed-size binary records,
+*       one for every cell change and every undo/redo pointer movement of the game moves log.
+*       Replaying the journal rebuilds the game board and the moves log.
+*
+* PUBLIC FUNCTIONS :
+*       Journal * openJournal(char * path, long validLength)
+*       int closeJournal(Journal * journal)
+*       int journalWriteHeader(Journal * journal, int mode, int m, int n, int ** board, int ** fixedBoard)
+*       int journalAppend(Journal * journal, int type, int row, int col, int value, int oldValue)
+*       int journalCommit(Journal * journal)
+*
+*       int readJournalHeader(FILE * fp, int * mode, int * m, int * n)
+*       int readJournalCell(FILE * fp, int * value, int * isFixed)
+*       int readJournalRecord(FILE * fp, JournalRecord * record)
+*       long getJournalLength(int N, int numOfRecords)
+*
+* NOTES :
+*       1. The journal file format is as follows (all integers are little endian):
+*           a. header - "SDKJ", format version (1 byte), game mode (1 byte), m (2 bytes), n (2 bytes).
+*           b. N*N cells, 2 bytes each, row by row: cell value, with the highest bit set iff the cell is fixed.
+*           c. records, JOURNAL_RECORD_SIZE bytes each: type, check byte, row, col, value and old value (2 bytes each).
+*       2. Records are buffered in memory and written to the file by journalCommit, once per command.
+*          The file is fsync'ed once every JOURNAL_SYNC_GROUP records (and when the journal is closed).
+*       3. A record that was only partially written (process died in the middle of a write) fails its check byte,
+*          so replay stops at the last complete record.
+*       4. A cell value takes 15 bits and a record value is a signed 16 bit number, so the journal only holds boards
+*          of up to JOURNAL_MAX_N*JOURNAL_MAX_N: a larger board isn't journaled, and a larger header is invalid.
+*
+************************************/
+
+/* journal file format constants */
+#define JOURNAL_MAGIC "SDKJ"
+#define JOURNAL_VERSION 1
+#define JOURNAL_HEADER_SIZE 10
+#define JOURNAL_CELL_SIZE 2
+#define JOURNAL_RECORD_SIZE 10
+#define JOURNAL_FIXED_CELL_BIT 0x8000
+
+/* max board size of the journal (the largest value of the cell and record encodings) */
+#define JOURNAL_MAX_N 0x7FFF
+
+/* size of the in-memory records buffer */
+#define JOURNAL_BUFFER_SIZE 4096
+
+/* number of records written between two fsync calls */
+#define JOURNAL_SYNC_GROUP 64
+
+/*
+ * journal record types:
+ * 1. JOURNAL_BEGIN_MOVE - a new move starts (the moves beyond the current move are cleared)
+ * 2. JOURNAL_CELL_CHANGE - a cell change of the newest move
+ * 3. JOURNAL_UNDO, JOURNAL_REDO - the current move pointer moved backward / forward
+ * 4. JOURNAL_RESET - all the moves were reverted and the moves log was cleared
+ */
+typedef enum journalRecordType {
+	JOURNAL_BEGIN_MOVE = 1, JOURNAL_CELL_CHANGE, JOURNAL_UNDO, JOURNAL_REDO, JOURNAL_RESET} journalRecordType;
+
+/*
+ * JournalRecord is a decoded journal record:
+ * type, and for JOURNAL_CELL_CHANGE records - cell indexes <row,col>,
+ * cell value after the change and cell value before the change
+ */
+typedef struct JournalRecord{
+	int type;
+	int row;
+	int col;
+	int value;
+	int oldValue;
+}JournalRecord;
+
+/*
+ * Journal struct holds an open journal file:
+ * 1. fd - the journal file descriptor
+ * 2. buffer, bufferLen - records that weren't written to the file yet
+ * 3. recordsSinceSync - number of records written since the last fsync
+ */
+typedef struct Journal{
+	int fd;
+	unsigned char buffer[JOURNAL_BUFFER_SIZE];
+	int bufferLen;
+	int recordsSinceSync;
+}Journal;
+
+/*
+ * opens the journal file in the given path for writing and returns a pointer to the journal.
+ * 1. if validLength is negative - the file is created or truncated.
+ * 2. otherwise - the file is truncated to validLength bytes and new records are appended to it.
+ * returns NULL if the file cannot be opened
+ */
+Journal * openJournal(char * path, long validLength);
+
+/*
+ * writes the buffered records, fsync the file, closes it and frees the journal.
+ * returns 1 iff all the records were written successfully
+ */
+int closeJournal(Journal * journal);
+
+/*
+ * starts the journal over:
+ * truncates the file and writes the header (game mode, block dimensions m, n and the board cells),
+ * fixed cells are the cells with non zero value in fixedBoard.
+ * returns 1 iff the header was written successfully (0 for a board larger than JOURNAL_MAX_N*JOURNAL_MAX_N)
+ */
+int journalWriteHeader(Journal * journal, int mode, int m, int n, int ** board, int ** fixedBoard);
+
+/*
+ * appends a record to the journal buffer.
+ * (row, col, value and oldValue are only meaningful for JOURNAL_CELL_CHANGE records)
+ * returns 1 iff the buffer could be written to the file when it was full
+ */
+int journalAppend(Journal * journal, int type, int row, int col, int value, int oldValue);
+
+/*
+ * writes the buffered records to the file with a single write,
+ * and fsync the file once JOURNAL_SYNC_GROUP records were written since the last fsync.
+ * returns 1 iff the records were written successfully
+ */
+int journalCommit(Journal * journal);
+
+/*
+ * reads the journal header from fp.
+ * returns 1 iff the header is valid (m*n is 1 to JOURNAL_MAX_N), and puts its values in mode, m and n
+ */
+int readJournalHeader(FILE * fp, int * mode, int * m, int * n);
+
+/*
+ * reads the next board cell of the journal header from fp.
+ * returns 1 iff a cell was read
+ */
+int readJournalCell(FILE * fp, int * value, int * isFixed);
+
+/*
+ * reads the next record from fp into record.
+ * returns 1 iff a complete and valid record was read
+ */
+int readJournalRecord(FILE * fp, JournalRecord * record);
+
+/*
+ * returns the length in bytes of a journal of an N*N board with numOfRecords records
+ */
+long getJournalLength(int N, int numOfRecords);
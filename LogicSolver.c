@@ -0,0 +1,684 @@
+#include <stdlib.h>
+#include <string.h>
+#include "Solver.h"
+#include "LogicSolver.h"
+
+/*
+ * LogicBoard is the state of a logic solve:
+ * 1. m, n, N - the block dimensions and the board size
+ * 2. words - the number of words in a bitset of N bits
+ * 3. cells - the cells values (0 for an empty cell), numbered row*N + col
+ * 4. candidates - the candidates bitset of every cell (empty for a filled cell)
+ * 5. numOfEmptyCells - the number of empty cells
+ * 6. matrix - N bitsets of N bits, the rows of the locked sets search (see findLockedSet)
+ * 7. unions - LOGIC_MAX_SUBSET_SIZE+1 bitsets, the union of the chosen rows at every depth of the search
+ * 8. stats - the statistics of the solve
+ */
+typedef struct LogicBoard{
+	int m;
+	int n;
+	int N;
+	int words;
+	int * cells;
+	unsigned long * candidates;
+	int numOfEmptyCells;
+	unsigned long * matrix;
+	unsigned long * unions;
+	LogicStats * stats;
+}LogicBoard;
+
+/***** LogicSolver inner functions *****/
+
+/*
+ * returns 1 iff bit number bit of the bitset is set
+ */
+int hasBit(unsigned long * set, int bit) {
+	return (int) ((set[bit / LOGIC_WORD_BITS] >> (bit % LOGIC_WORD_BITS)) & 1UL);
+}
+
+/*
+ * sets bit number bit of the bitset
+ */
+void setBit(unsigned long * set, int bit) {
+	set[bit / LOGIC_WORD_BITS] |= 1UL << (bit % LOGIC_WORD_BITS);
+}
+
+/*
+ * clears bit number bit of the bitset
+ */
+void clearBit(unsigned long * set, int bit) {
+	set[bit / LOGIC_WORD_BITS] &= ~(1UL << (bit % LOGIC_WORD_BITS));
+}
+
+/*
+ * returns the number of set bits in the bitset of the given number of words
+ */
+int countBits(unsigned long * set, int words) {
+	int cnt = 0;
+	int w;
+	unsigned long word;
+
+	for (w = 0; w < words; w++) {
+		/* every iteration clears the lowest set bit */
+		for (word = set[w]; word != 0; word &= word - 1) {
+			cnt++;
+		}
+	}
+	return cnt;
+}
+
+/*
+ * returns the number of the lowest set bit in the bitset of the given number of words, or -1 if it is empty
+ */
+int getFirstBit(unsigned long * set, int words) {
+	int w;
+	int bit;
+
+	for (w = 0; w < words; w++) {
+		if (set[w] == 0) {
+			continue;
+		}
+		for (bit = 0; ((set[w] >> bit) & 1UL) == 0; bit++);
+		return w*LOGIC_WORD_BITS + bit;
+	}
+	return -1;
+}
+
+/*
+ * returns the candidates bitset of the cell
+ */
+unsigned long * getCellCandidates(LogicBoard * logic, int cell) {
+	return logic->candidates + (long) cell*logic->words;
+}
+
+/*
+ * returns row number row of the locked sets search matrix
+ */
+unsigned long * getMatrixRow(LogicBoard * logic, int row) {
+	return logic->matrix + (long) row*logic->words;
+}
+
+/*
+ * puts in units the numbers of the row, the column and the block of the cell (see getUnitCell in Solver.h)
+ */
+void getCellUnits(LogicBoard * logic, int cell, int * units) {
+	int row = cell / logic->N;
+	int col = cell % logic->N;
+
+	units[0] = row;
+	units[1] = logic->N + col;
+	units[2] = 2*logic->N + (row / logic->m)*logic->m + col / logic->n;
+}
+
+/*
+ * returns 1 iff the cell is in the unit
+ */
+int isCellInUnit(LogicBoard * logic, int cell, int unit) {
+	int units[3];
+
+	getCellUnits(logic, cell, units);
+	return units[0] == unit || units[1] == unit || units[2] == unit;
+}
+
+/*
+ * puts value in the empty cell and removes it from the candidates of the cell peers.
+ * the cell is counted as filled by the technique
+ */
+void placeLogicValue(LogicBoard * logic, int cell, int value, int technique) {
+	int units[3];
+	int u;
+	int k;
+
+	logic->cells[cell] = value;
+	memset(getCellCandidates(logic, cell), 0, logic->words*sizeof(unsigned long));
+	logic->numOfEmptyCells--;
+	logic->stats->filledCells[technique]++;
+
+	getCellUnits(logic, cell, units);
+	for (u = 0; u < 3; u++) {
+		for (k = 0; k < logic->N; k++) {
+			clearBit(getCellCandidates(logic, getUnitCell(logic->m, logic->n, units[u], k)), value - 1);
+		}
+	}
+}
+
+/*
+ * removes value from the candidates of the cell, counted as removed by the technique.
+ * returns 1 iff it was a candidate
+ */
+int eliminateCandidate(LogicBoard * logic, int cell, int value, int technique) {
+	unsigned long * candidates = getCellCandidates(logic, cell);
+
+	if (hasBit(candidates, value - 1) == 0) {
+		return 0;
+	}
+	clearBit(candidates, value - 1);
+	logic->stats->eliminatedCandidates[technique]++;
+	return 1;
+}
+
+/*
+ * frees the memory of the logic board
+ */
+void freeLogicBoard(LogicBoard * logic) {
+	free(logic->cells);
+	free(logic->candidates);
+	free(logic->matrix);
+	free(logic->unions);
+}
+
+/*
+ * initializes the logic board from the board: every empty cell starts with the values that its filled peers don't have.
+ * returns SUDOKU_UNSOLVABLE if a value is outside 1..N or two peers have the same value,
+ * SUDOKU_OUT_OF_MEMORY if an allocation failed,
+ * otherwise SUDOKU_OK. the logic board has to be freed with freeLogicBoard either way
+ */
+int initLogicBoard(LogicBoard * logic, int ** board, int m, int n, LogicStats * stats) {
+	int N = m*n;
+	int cell;
+	int value;
+	int units[3];
+	int u;
+	int k;
+	int peer;
+
+	logic->m = m;
+	logic->n = n;
+	logic->N = N;
+	logic->words = (N + LOGIC_WORD_BITS - 1) / LOGIC_WORD_BITS;
+	logic->numOfEmptyCells = 0;
+	logic->stats = stats;
+	logic->cells = (int *) malloc((long) N*N*sizeof(int));
+	logic->candidates = (unsigned long *) calloc((long) N*N*logic->words, sizeof(unsigned long));
+	logic->matrix = (unsigned long *) malloc((long) N*logic->words*sizeof(unsigned long));
+	logic->unions = (unsigned long *) malloc((LOGIC_MAX_SUBSET_SIZE + 1)*logic->words*sizeof(unsigned long));
+	if (logic->cells == NULL || logic->candidates == NULL || logic->matrix == NULL || logic->unions == NULL) {
+		return SUDOKU_OUT_OF_MEMORY;
+	}
+
+	for (cell = 0; cell < N*N; cell++) {
+		logic->cells[cell] = board[cell / N][cell % N];
+		/* a value outside 1..N has no candidate bit */
+		if (logic->cells[cell] < 0 || logic->cells[cell] > N) {
+			return SUDOKU_UNSOLVABLE;
+		}
+		if (logic->cells[cell] != 0) {
+			continue;
+		}
+		logic->numOfEmptyCells++;
+		for (value = 1; value <= N; value++) {
+			setBit(getCellCandidates(logic, cell), value - 1);
+		}
+	}
+
+	for (cell = 0; cell < N*N; cell++) {
+		value = logic->cells[cell];
+		if (value == 0) {
+			continue;
+		}
+		getCellUnits(logic, cell, units);
+		for (u = 0; u < 3; u++) {
+			for (k = 0; k < N; k++) {
+				peer = getUnitCell(m, n, units[u], k);
+				if (peer != cell && logic->cells[peer] == value) {
+					return SUDOKU_UNSOLVABLE;
+				}
+				clearBit(getCellCandidates(logic, peer), value - 1);
+			}
+		}
+	}
+	return SUDOKU_OK;
+}
+
+/*
+ * fills every empty cell that has a single candidate.
+ * returns the number of cells filled, or -1 if an empty cell has no candidates
+ */
+int fillNakedSingles(LogicBoard * logic) {
+	int cell;
+	int cnt;
+	int filled = 0;
+
+	for (cell = 0; cell < logic->N*logic->N; cell++) {
+		if (logic->cells[cell] != 0) {
+			continue;
+		}
+		cnt = countBits(getCellCandidates(logic, cell), logic->words);
+		if (cnt == 0) {
+			return -1;
+		}
+		if (cnt == 1) {
+			placeLogicValue(logic, cell, getFirstBit(getCellCandidates(logic, cell), logic->words) + 1,
+					LOGIC_NAKED_SINGLES);
+			filled++;
+		}
+	}
+	return filled;
+}
+
+/*
+ * fills every value that has a single candidate cell in a row, column or block.
+ * returns the number of cells filled, or -1 if a value that a unit is missing has no candidate cell in it
+ */
+int fillHiddenSingles(LogicBoard * logic) {
+	int N = logic->N;
+	int unit;
+	int value;
+	int k;
+	int cell;
+	int cnt;
+	int isPlaced;
+	int last = 0;
+	int filled = 0;
+
+	for (unit = 0; unit < 3*N; unit++) {
+		for (value = 1; value <= N; value++) {
+			cnt = 0;
+			isPlaced = 0;
+			for (k = 0; k < N && isPlaced == 0; k++) {
+				cell = getUnitCell(logic->m, logic->n, unit, k);
+				isPlaced = logic->cells[cell] == value;
+				if (logic->cells[cell] == 0 && hasBit(getCellCandidates(logic, cell), value - 1) == 1) {
+					cnt++;
+					last = cell;
+				}
+			}
+			if (isPlaced == 1) {
+				continue;
+			}
+			if (cnt == 0) {
+				return -1;
+			}
+			if (cnt == 1) {
+				placeLogicValue(logic, last, value, LOGIC_HIDDEN_SINGLES);
+				filled++;
+			}
+		}
+	}
+	return filled;
+}
+
+/*
+ * removes value from the cells of unit that aren't in the unit other.
+ * returns the number of candidates removed
+ */
+int eliminateOutsideUnit(LogicBoard * logic, int unit, int other, int value) {
+	int k;
+	int cell;
+	int removed = 0;
+
+	for (k = 0; k < logic->N; k++) {
+		cell = getUnitCell(logic->m, logic->n, unit, k);
+		if (isCellInUnit(logic, cell, other) == 0) {
+			removed += eliminateCandidate(logic, cell, value, LOGIC_LOCKED_CANDIDATES);
+		}
+	}
+	return removed;
+}
+
+/*
+ * removes the locked candidates: when the candidate cells of a value in a unit all share another unit
+ * (a block and a row or a column, either way), the value is removed from the rest of that other unit.
+ * returns the number of candidates removed
+ */
+int eliminateLockedCandidates(LogicBoard * logic) {
+	int N = logic->N;
+	int unit;
+	int value;
+	int k;
+	int u;
+	int cell;
+	int cnt;
+	int units[3];
+	int common[3];
+	int removed = 0;
+
+	for (unit = 0; unit < 3*N; unit++) {
+		for (value = 1; value <= N; value++) {
+			/* common - the units all the candidate cells of the value share (-1 where they don't) */
+			cnt = 0;
+			for (k = 0; k < N; k++) {
+				cell = getUnitCell(logic->m, logic->n, unit, k);
+				if (hasBit(getCellCandidates(logic, cell), value - 1) == 0) {
+					continue;
+				}
+				getCellUnits(logic, cell, units);
+				for (u = 0; u < 3; u++) {
+					common[u] = (cnt == 0 || common[u] == units[u]) ? units[u] : -1;
+				}
+				cnt++;
+			}
+			if (cnt < 2) {
+				continue;
+			}
+			for (u = 0; u < 3; u++) {
+				if (common[u] != -1 && common[u] != unit) {
+					removed += eliminateOutsideUnit(logic, common[u], unit, value);
+				}
+			}
+		}
+	}
+	return removed;
+}
+
+/*
+ * returns 1 iff row is one of the size chosen rows
+ */
+int isChosenRow(int row, int * chosen, int size) {
+	int d;
+
+	for (d = 0; d < size; d++) {
+		if (chosen[d] == row) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * returns 1 iff a row of the matrix (numOfRows rows) that wasn't chosen has some of the bits of the chosen rows union
+ */
+int isLockedSetUseful(LogicBoard * logic, int numOfRows, int size, int * chosen) {
+	unsigned long * lockedBits = logic->unions + (long) size*logic->words;
+	int row;
+	int w;
+
+	for (row = 0; row < numOfRows; row++) {
+		if (isChosenRow(row, chosen, size) == 1) {
+			continue;
+		}
+		for (w = 0; w < logic->words; w++) {
+			if ((getMatrixRow(logic, row)[w] & lockedBits[w]) != 0) {
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+/*
+ * the locked sets search, that finds the naked subsets, the hidden subsets and the fish (see the notes in LogicSolver.h):
+ * searches the matrix (numOfRows rows) for a locked set - size rows, each with 2 to size bits, whose union has
+ * exactly size bits, while another row has some of these bits (these bits can be removed from the other rows).
+ * depth rows were chosen so far (in chosen, with their union in unions[depth]), and the next ones are chosen from row start on.
+ * returns 1 iff a locked set was found (in chosen, with its union in unions[size]),
+ * -1 if rows whose union has fewer bits than their number were found (a contradiction), otherwise 0
+ */
+int findLockedSet(LogicBoard * logic, int numOfRows, int size, int * chosen, int depth, int start) {
+	int words = logic->words;
+	unsigned long * prev = logic->unions + (long) depth*words;
+	unsigned long * next = logic->unions + (long) (depth + 1)*words;
+	int row;
+	int w;
+	int cnt;
+	int found;
+
+	for (row = start; row < numOfRows; row++) {
+		cnt = countBits(getMatrixRow(logic, row), words);
+		if (cnt < 2 || cnt > size) {
+			continue;
+		}
+		for (w = 0; w < words; w++) {
+			next[w] = prev[w] | getMatrixRow(logic, row)[w];
+		}
+		cnt = countBits(next, words);
+		if (cnt < depth + 1) {
+			return -1;
+		}
+		if (cnt > size) {
+			continue;
+		}
+		chosen[depth] = row;
+		if (depth + 1 < size) {
+			found = findLockedSet(logic, numOfRows, size, chosen, depth + 1, row + 1);
+			if (found != 0) {
+				return found;
+			}
+		}
+		else if (isLockedSetUseful(logic, numOfRows, size, chosen) == 1) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * finds the locked sets of every size up to LOGIC_MAX_SUBSET_SIZE in the matrix (numOfRows rows, see findLockedSet),
+ * and clears the bits of each of them from the other rows.
+ * returns the number of locked sets found, or -1 on a contradiction
+ */
+int clearLockedSets(LogicBoard * logic, int numOfRows) {
+	int chosen[LOGIC_MAX_SUBSET_SIZE];
+	unsigned long * lockedBits;
+	int size = 2;
+	int found;
+	int numOfSets = 0;
+	int row;
+	int w;
+
+	/* the union of no rows */
+	memset(logic->unions, 0, logic->words*sizeof(unsigned long));
+	while (size <= LOGIC_MAX_SUBSET_SIZE && size < numOfRows) {
+		found = findLockedSet(logic, numOfRows, size, chosen, 0, 0);
+		if (found == -1) {
+			return -1;
+		}
+		if (found == 0) {
+			size++;
+			continue;
+		}
+		lockedBits = logic->unions + (long) size*logic->words;
+		for (row = 0; row < numOfRows; row++) {
+			if (isChosenRow(row, chosen, size) == 0) {
+				for (w = 0; w < logic->words; w++) {
+					getMatrixRow(logic, row)[w] &= ~lockedBits[w];
+				}
+			}
+		}
+		numOfSets++;
+	}
+	return numOfSets;
+}
+
+/*
+ * removes the candidates the naked subsets lock: the matrix rows are the cells of a unit, and the bits their candidates.
+ * returns the number of candidates removed, or -1 on a contradiction
+ */
+int eliminateNakedSubsets(LogicBoard * logic) {
+	int N = logic->N;
+	int unit;
+	int k;
+	int value;
+	int cell;
+	int found;
+	int removed = 0;
+
+	for (unit = 0; unit < 3*N; unit++) {
+		for (k = 0; k < N; k++) {
+			cell = getUnitCell(logic->m, logic->n, unit, k);
+			memcpy(getMatrixRow(logic, k), getCellCandidates(logic, cell), logic->words*sizeof(unsigned long));
+		}
+		found = clearLockedSets(logic, N);
+		if (found == -1) {
+			return -1;
+		}
+		for (k = 0; k < N && found > 0; k++) {
+			cell = getUnitCell(logic->m, logic->n, unit, k);
+			for (value = 1; value <= N; value++) {
+				if (hasBit(getMatrixRow(logic, k), value - 1) == 0) {
+					removed += eliminateCandidate(logic, cell, value, LOGIC_NAKED_SUBSETS);
+				}
+			}
+		}
+	}
+	return removed;
+}
+
+/*
+ * removes the candidates the hidden subsets lock: the matrix rows are the values, and the bits the cells of a unit
+ * the value can go to. returns the number of candidates removed, or -1 on a contradiction
+ */
+int eliminateHiddenSubsets(LogicBoard * logic) {
+	int N = logic->N;
+	int unit;
+	int k;
+	int value;
+	int cell;
+	int found;
+	int removed = 0;
+
+	for (unit = 0; unit < 3*N; unit++) {
+		memset(logic->matrix, 0, (long) N*logic->words*sizeof(unsigned long));
+		for (k = 0; k < N; k++) {
+			cell = getUnitCell(logic->m, logic->n, unit, k);
+			for (value = 1; value <= N; value++) {
+				if (hasBit(getCellCandidates(logic, cell), value - 1) == 1) {
+					setBit(getMatrixRow(logic, value - 1), k);
+				}
+			}
+		}
+		found = clearLockedSets(logic, N);
+		if (found == -1) {
+			return -1;
+		}
+		for (k = 0; k < N && found > 0; k++) {
+			cell = getUnitCell(logic->m, logic->n, unit, k);
+			for (value = 1; value <= N; value++) {
+				if (hasBit(getMatrixRow(logic, value - 1), k) == 0) {
+					removed += eliminateCandidate(logic, cell, value, LOGIC_HIDDEN_SUBSETS);
+				}
+			}
+		}
+	}
+	return removed;
+}
+
+/*
+ * removes the candidates the basic fish lock: for every value, the matrix rows are the rows of the board
+ * (and then its columns), and the bits the cells of the row (column) the value can go to.
+ * returns the number of candidates removed, or -1 on a contradiction
+ */
+int eliminateFish(LogicBoard * logic) {
+	int N = logic->N;
+	int firstUnit;
+	int line;
+	int k;
+	int value;
+	int cell;
+	int found;
+	int removed = 0;
+
+	for (value = 1; value <= N; value++) {
+		/* the rows are units 0 to N-1 and the columns are units N to 2N-1 */
+		for (firstUnit = 0; firstUnit <= N; firstUnit += N) {
+			memset(logic->matrix, 0, (long) N*logic->words*sizeof(unsigned long));
+			for (line = 0; line < N; line++) {
+				for (k = 0; k < N; k++) {
+					cell = getUnitCell(logic->m, logic->n, firstUnit + line, k);
+					if (hasBit(getCellCandidates(logic, cell), value - 1) == 1) {
+						setBit(getMatrixRow(logic, line), k);
+					}
+				}
+			}
+			found = clearLockedSets(logic, N);
+			if (found == -1) {
+				return -1;
+			}
+			for (line = 0; line < N && found > 0; line++) {
+				for (k = 0; k < N; k++) {
+					if (hasBit(getMatrixRow(logic, line), k) == 0) {
+						cell = getUnitCell(logic->m, logic->n, firstUnit + line, k);
+						removed += eliminateCandidate(logic, cell, value, LOGIC_FISH);
+					}
+				}
+			}
+		}
+	}
+	return removed;
+}
+
+/*
+ * runs a single technique over the whole board.
+ * returns its progress (the number of cells filled or candidates removed), or -1 if it found a contradiction
+ */
+int runLogicTechnique(LogicBoard * logic, int technique) {
+	switch (technique) {
+		case LOGIC_NAKED_SINGLES:
+			return fillNakedSingles(logic);
+		case LOGIC_HIDDEN_SINGLES:
+			return fillHiddenSingles(logic);
+		case LOGIC_LOCKED_CANDIDATES:
+			return eliminateLockedCandidates(logic);
+		case LOGIC_NAKED_SUBSETS:
+			return eliminateNakedSubsets(logic);
+		case LOGIC_HIDDEN_SUBSETS:
+			return eliminateHiddenSubsets(logic);
+		default:
+			return eliminateFish(logic);
+	}
+}
+
+
+/***** LogicSolver.h implementation *****/
+
+int solveBoardWithLogic(int ** board, int m, int n, int ** result, LogicStats * stats){
+	LogicBoard logic;
+	LogicStats ignoredStats;
+	SolverDeadline clock;
+	int technique;
+	int progress;
+	int status;
+	int N = m*n;
+	int i;
+
+	if (stats == NULL){
+		stats = &ignoredStats;
+	}
+	for (technique = 0; technique < NUM_OF_LOGIC_TECHNIQUES; technique++){
+		stats->filledCells[technique] = 0;
+		stats->eliminatedCandidates[technique] = 0;
+		stats->seconds[technique] = 0;
+	}
+
+	status = initLogicBoard(&logic, board, m, n, stats);
+	/* every step runs the simplest technique that makes progress */
+	while (status == SUDOKU_OK && logic.numOfEmptyCells > 0){
+		progress = 0;
+		for (technique = 0; technique < NUM_OF_LOGIC_TECHNIQUES && progress == 0; technique++){
+			setSolverDeadline(&clock, 0);
+			progress = runLogicTechnique(&logic, technique);
+			stats->seconds[technique] += getSolverElapsedSeconds(&clock);
+		}
+		if (progress == -1){
+			status = SUDOKU_UNSOLVABLE;
+		}
+		else if (progress == 0){
+			status = SUDOKU_UNDECIDED;
+		}
+	}
+
+	if (status == SUDOKU_OK || status == SUDOKU_UNDECIDED){
+		for (i = 0; i < N; i++){
+			memcpy(result[i], logic.cells + (long) i*N, N*sizeof(int));
+		}
+	}
+	freeLogicBoard(&logic);
+	return status;
+}
+
+char * getLogicTechniqueName(int technique){
+	switch (technique){
+		case LOGIC_NAKED_SINGLES:
+			return "naked singles";
+		case LOGIC_HIDDEN_SINGLES:
+			return "hidden singles";
+		case LOGIC_LOCKED_CANDIDATES:
+			return "locked candidates";
+		case LOGIC_NAKED_SUBSETS:
+			return "naked subsets";
+		case LOGIC_HIDDEN_SUBSETS:
+			return "hidden subsets";
+		default:
+			return "fish";
+	}
+}
@@ -0,0 +1,74 @@
+/************************************
+* FILES NAMES :        LogicSolver.c , LogicSolver.h
+*
+* DESCRIPTION :
+*       Logical step solving (part of libsudoku): solves the board the way a person does, with polynomial time
+*       techniques over the candidates of the empty cells, and tells how much each technique did and how long it took.
+*       Most newspaper puzzles are solved by logic alone, with no ILP and no search.
+*
+* PUBLIC FUNCTIONS :
+*       int solveBoardWithLogic(int ** board, int m, int n, int ** result, LogicStats * stats)
+*       char * getLogicTechniqueName(int technique)
+*
+* NOTES :
+*       1. The candidates of every empty cell are kept as a bitset (bit v-1 for value v) of LOGIC_WORD_BITS bit words,
+*          so any board size is supported. Placing a value removes it from the candidates of the cell peers.
+*       2. The techniques, from the simplest one:
+*           a. naked singles - an empty cell with a single candidate gets it.
+*           b. hidden singles - a value with a single candidate cell in a row, column or block goes there.
+*           c. locked candidates - the candidates of a value in a block that are all in one row (or column)
+*              are removed from the rest of that row, and the candidates of a value in a row (or column)
+*              that are all in one block are removed from the rest of that block.
+*           d. naked subsets - k cells of a row, column or block whose candidates are only k values:
+*              the values are removed from the other cells of the unit.
+*           e. hidden subsets - k values whose candidate cells in a row, column or block are only k cells:
+*              the other candidates of those cells are removed.
+*           f. basic fish (X-Wing, Swordfish, Jellyfish) - k rows whose candidates of a value are only in k columns:
+*              the value is removed from the rest of those columns (and the same with the columns as the base).
+*          Subsets and fish are up to LOGIC_MAX_SUBSET_SIZE, and are all found by the same search (see LogicSolver.c).
+*       3. Every step runs the simplest technique that makes progress, and the solver stops when no technique does.
+*       4. Like the rest of libsudoku, the logic solver never prints and never exits.
+*       5. The files that include LogicSolver.h must include Solver.h before it.
+*
+************************************/
+
+/* number of bits in a word of a candidates bitset */
+#define LOGIC_WORD_BITS ((int) (8 * sizeof(unsigned long)))
+
+/* max size of the subsets and the fish the logic solver looks for (quads and Jellyfish) */
+#define LOGIC_MAX_SUBSET_SIZE 4
+
+/*
+ * the logic solver techniques, from the simplest one (see the notes above)
+ */
+typedef enum logicTechnique {
+	LOGIC_NAKED_SINGLES = 0, LOGIC_HIDDEN_SINGLES, LOGIC_LOCKED_CANDIDATES, LOGIC_NAKED_SUBSETS,
+	LOGIC_HIDDEN_SUBSETS, LOGIC_FISH, NUM_OF_LOGIC_TECHNIQUES} logicTechnique;
+
+/*
+ * LogicStats are the statistics of a logic solve, per technique:
+ * 1. filledCells - the number of cells the technique filled (only the singles fill cells)
+ * 2. eliminatedCandidates - the number of candidates the technique removed
+ * 3. seconds - the time spent in the technique
+ */
+typedef struct LogicStats{
+	int filledCells[NUM_OF_LOGIC_TECHNIQUES];
+	long eliminatedCandidates[NUM_OF_LOGIC_TECHNIQUES];
+	double seconds[NUM_OF_LOGIC_TECHNIQUES];
+}LogicStats;
+
+/*
+ * solves the board with the logic techniques until it is filled or no technique makes progress.
+ * returns:
+ * 1. SUDOKU_OK - the board was filled completely (so it has a single solution), and it is written to result.
+ * 2. SUDOKU_UNDECIDED - the solver got stuck, and the board with the cells it filled is written to result.
+ * 3. SUDOKU_UNSOLVABLE - a contradiction was found, or the board has a value outside 1..N (result isn't changed).
+ * 4. SUDOKU_OUT_OF_MEMORY - a memory allocation failed.
+ * result may be the board itself. the statistics of the techniques are put in stats, unless it is NULL
+ */
+int solveBoardWithLogic(int ** board, int m, int n, int ** result, LogicStats * stats);
+
+/*
+ * returns the name of the logic technique
+ */
+char * getLogicTechniqueName(int technique);
@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MoveLog.h"
+#include "mainAux.h"
+
+/***** MoveLog inner functions *****/
+
+/*
+ * return the index in log->moveStarts of the move number moveNum
+ * (moves are numbered from the oldest retained move)
+ */
+int getMoveIndex(MoveLog * log, int moveNum) {
+	return (log->firstMove + moveNum) % log->movesCapacity;
+}
+
+/*
+ * return the index one past the last change of move number moveNum
+ */
+int getMoveEnd(MoveLog * log, int moveNum) {
+	if(moveNum + 1 < log->numOfMoves) {
+		return log->moveStarts[getMoveIndex(log, moveNum + 1)];
+	}
+	return log->changesEnd;
+}
+
+/*
+ * drop the oldest retained move from the log
+ */
+void dropOldestMove(MoveLog * log) {
+	log->firstMove = (log->firstMove + 1) % log->movesCapacity;
+	log->numOfMoves--;
+	log->currMove--;
+	if(log->numOfMoves > 0) {
+		log->changesStart = log->moveStarts[log->firstMove];
+	}
+	else {
+		log->changesStart = log->changesEnd;
+	}
+}
+
+/*
+ * make room for one more move in the moves ring.
+ * the ring is reallocated (and unrolled so the oldest move is first)
+ * only when it is full
+ */
+void growMovesRing(MoveLog * log) {
+	int k;
+	int newCapacity;
+	int * newStarts;
+
+	if(log->numOfMoves < log->movesCapacity) {
+		return;
+	}
+
+	newCapacity = 2 * log->movesCapacity;
+	if(log->maxMoves > 0 && newCapacity > log->maxMoves) {
+		newCapacity = log->maxMoves;
+	}
+
+	newStarts = (int *) malloc(newCapacity * sizeof(int));
+	if (newStarts == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	for(k = 0; k < log->numOfMoves; k++) {
+		newStarts[k] = log->moveStarts[getMoveIndex(log, k)];
+	}
+	free(log->moveStarts);
+	log->moveStarts = newStarts;
+	log->movesCapacity = newCapacity;
+	log->firstMove = 0;
+}
+
+/*
+ * make room for one more cell change in the changes arena.
+ * if more than half of the arena belongs to dropped moves,
+ * the retained changes are moved to the arena start.
+ * otherwise the arena is reallocated in double size
+ */
+void growChangesArena(MoveLog * log) {
+	int k;
+	int shift;
+	CellChange * newChanges;
+
+	if(log->changesEnd < log->changesCapacity) {
+		return;
+	}
+
+	if(log->changesStart > log->changesCapacity / 2) {
+		shift = log->changesStart;
+		memmove(log->changes, log->changes + shift,
+				(log->changesEnd - shift) * sizeof(CellChange));
+		for(k = 0; k < log->numOfMoves; k++) {
+			log->moveStarts[getMoveIndex(log, k)] -= shift;
+		}
+		log->changesStart = 0;
+		log->changesEnd -= shift;
+		return;
+	}
+
+	newChanges = (CellChange *) realloc(log->changes,
+			2 * log->changesCapacity * sizeof(CellChange));
+	if (newChanges == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	log->changes = newChanges;
+	log->changesCapacity *= 2;
+}
+
+
+/***** MoveLog.h implementation *****/
+
+MoveLog * createMoveLog(int maxMoves) {
+	MoveLog * log = (MoveLog *) malloc(sizeof(MoveLog));
+	if (log == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+
+	log->maxMoves = maxMoves;
+	log->changesCapacity = MOVE_LOG_INITIAL_CHANGES;
+	log->movesCapacity = MOVE_LOG_INITIAL_MOVES;
+	if(maxMoves > 0 && log->movesCapacity > maxMoves) {
+		log->movesCapacity = maxMoves;
+	}
+
+	log->changes = (CellChange *) malloc(log->changesCapacity * sizeof(CellChange));
+	log->moveStarts = (int *) malloc(log->movesCapacity * sizeof(int));
+	if (log->changes == NULL || log->moveStarts == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+
+	clearMoveLog(log);
+	return log;
+}
+
+void freeMoveLog(MoveLog * log) {
+	if(log != NULL) {
+		free(log->changes);
+		free(log->moveStarts);
+		free(log);
+	}
+}
+
+void clearMoveLog(MoveLog * log) {
+	log->changesStart = 0;
+	log->changesEnd = 0;
+	log->firstMove = 0;
+	log->numOfMoves = 0;
+	log->currMove = 0;
+}
+
+void deleteAfterPointer(MoveLog * log) {
+	if(log->currMove < log->numOfMoves) {
+		log->changesEnd = log->moveStarts[getMoveIndex(log, log->currMove)];
+		log->numOfMoves = log->currMove;
+	}
+}
+
+void beginMove(MoveLog * log) {
+	/* clear any move beyond the current move from the log */
+	deleteAfterPointer(log);
+
+	/* if the log is full - drop the oldest move */
+	if(log->maxMoves > 0 && log->numOfMoves == log->maxMoves) {
+		dropOldestMove(log);
+	}
+	growMovesRing(log);
+
+	/* the new move starts at the end of the changes arena */
+	log->moveStarts[getMoveIndex(log, log->numOfMoves)] = log->changesEnd;
+	log->numOfMoves++;
+	log->currMove = log->numOfMoves;
+}
+
+void addCellChange(MoveLog * log, int i, int j, int z, int oldZ) {
+	CellChange * change;
+
+	growChangesArena(log);
+	change = &(log->changes[log->changesEnd]);
+	change->row = (short) i;
+	change->col = (short) j;
+	change->value = (short) z;
+	change->oldValue = (short) oldZ;
+	log->changesEnd++;
+}
+
+void addSetMoveToMovesList(MoveLog * log, int i, int j, int z, int oldZ) {
+	beginMove(log);
+	addCellChange(log, i, j, z, oldZ);
+}
+
+int getMoveChanges(MoveLog * log, int isUndo, CellChange ** changes) {
+	int moveNum;
+	int start;
+
+	if(isUndo == 1) {
+		moveNum = log->currMove - 1;
+	}
+	else {
+		moveNum = log->currMove;
+	}
+
+	start = log->moveStarts[getMoveIndex(log, moveNum)];
+	*changes = log->changes + start;
+	return getMoveEnd(log, moveNum) - start;
+}
+
+void setMovePointerForward(MoveLog * log) {
+	log->currMove++;
+}
+
+void setMovePointerBackward(MoveLog * log) {
+	log->currMove--;
+}
+
+int checkUndoAvailable(MoveLog * log) {
+	if(log == NULL || log->currMove == 0) {
+		return 0;
+	}
+	return 1;
+}
+
+int checkRedoAvailable(MoveLog * log) {
+	if(log == NULL || log->currMove == log->numOfMoves) {
+		return 0;
+	}
+	return 1;
+}
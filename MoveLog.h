@@ -0,0 +1,158 @@
+/************************************
+* FILES NAMES :        MoveLog.c , MoveLog.h
+*
+* DESCRIPTION :
+*       The sudoku game undo-redo moves log.
+*       Cell changes are kept packed in one contiguous array (the changes arena),
+*       and the boundaries of the moves are kept in a second array of indexes into it.
+*
+* PUBLIC FUNCTIONS :
+*       MoveLog * createMoveLog(int maxMoves)
+*       void freeMoveLog(MoveLog * log)
+*       void clearMoveLog(MoveLog * log)
+*       void deleteAfterPointer(MoveLog * log)
+*       void beginMove(MoveLog * log)
+*       void addCellChange(MoveLog * log, int i, int j, int z, int oldZ)
+*       void addSetMoveToMovesList(MoveLog * log, int i, int j, int z, int oldZ)
+*       int getMoveChanges(MoveLog * log, int isUndo, CellChange ** changes)
+*       void setMovePointerForward(MoveLog * log)
+*       void setMovePointerBackward(MoveLog * log)
+*       int checkUndoAvailable(MoveLog * log)
+*       int checkRedoAvailable(MoveLog * log)
+*
+* NOTES :
+*       1. MoveLog.h contains the definition of the following:
+*           a. CellChange struct - a packed description of a single cell change
+*              (cell indexes, value after the change and value before the change).
+*           b. MoveLog struct - the moves log itself, as described in the full documentation below.
+*       2. Moves are numbered from the oldest retained move (0) to the newest one (numOfMoves-1).
+*          currMove is the number of moves that are currently applied to the board,
+*          so undo reverts move currMove-1 and redo re-applies move currMove.
+*       3. The move boundaries array is a ring. If maxMoves is not 0 and the log is full,
+*          beginning a new move drops the oldest one.
+*       4. Clearing the moves beyond the current move (deleteAfterPointer) and clearing the whole log
+*          only move indexes, so they take O(1) and keep the allocated memory for the next moves.
+*
+************************************/
+
+/* initial capacities of the log arrays */
+#define MOVE_LOG_INITIAL_CHANGES 64
+#define MOVE_LOG_INITIAL_MOVES 16
+
+/*
+ * CellChange describes a single cell change in one game command:
+ * 1. row, col - cell indexes
+ * 2. value - cell value AFTER command execution
+ * 3. oldValue - cell value BEFORE command execution
+ * the fields are ints: boards may be up to BINARY_BOARD_MAX_N*BINARY_BOARD_MAX_N (see BoardFile.h), beyond a short
+ */
+typedef struct CellChange{
+	int row;
+	int col;
+	int value;
+	int oldValue;
+}CellChange;
+
+/*
+ * MoveLog is a struct that contains:
+ *
+ * 1. changes arena:
+ * 		a. changes - all the cell changes of the retained moves, in order of execution
+ * 		b. changesStart - index of the first change of the oldest retained move
+ * 		c. changesEnd - index one past the last change of the newest move
+ * 		d. changesCapacity - allocated size of changes
+ * 2. moves ring:
+ * 		a. moveStarts - for each retained move, the index of its first change in changes
+ * 		b. firstMove - index of the oldest retained move in moveStarts
+ * 		c. numOfMoves - number of retained moves
+ * 		d. movesCapacity - allocated size of moveStarts
+ * 3. currMove - number of moves that are applied to the board
+ * 4. maxMoves - max number of retained moves, 0 for unlimited
+ */
+typedef struct MoveLog{
+	CellChange * changes;
+	int changesStart;
+	int changesEnd;
+	int changesCapacity;
+
+	int * moveStarts;
+	int firstMove;
+	int numOfMoves;
+	int movesCapacity;
+
+	int currMove;
+
+	int maxMoves;
+}MoveLog;
+
+/*
+ * allocates a new empty moves log and returns a pointer to it.
+ * maxMoves is the max number of moves the log keeps (0 for unlimited)
+ */
+MoveLog * createMoveLog(int maxMoves);
+
+/*
+ * frees all of the moves log memory.
+ * if log is NULL the function doesn't perform any operation
+ */
+void freeMoveLog(MoveLog * log);
+
+/*
+ * clears all the moves from the log (without freeing its memory)
+ */
+void clearMoveLog(MoveLog * log);
+
+/*
+ * clears any move beyond the current move from the log
+ */
+void deleteAfterPointer(MoveLog * log);
+
+/*
+ * starts a new move:
+ * clears any move beyond the current move from the log,
+ * drops the oldest move if the log is full,
+ * then adds a new empty move to the end of the log and marks it as the current move.
+ * the move cell changes are added afterwards with addCellChange
+ */
+void beginMove(MoveLog * log);
+
+/*
+ * gets cell indexes <i,j>, cell new value (z) and cell previous value (oldZ)
+ * and adds the cell change to the newest move in the log
+ */
+void addCellChange(MoveLog * log, int i, int j, int z, int oldZ);
+
+/*
+ * gets a pointer to the MoveLog, as well as cell indexes <i,j>,
+ * cells new value (z) and cell previous value before the set command execution (oldZ).
+ * The function clears any move beyond the current move from the log,
+ * then add the new move to the end of the log and mark it as the current move.
+ */
+void addSetMoveToMovesList(MoveLog * log, int i, int j, int z, int oldZ);
+
+/*
+ * gets the cell changes of the move that undo (isUndo = 1) or redo (isUndo = 0) should execute.
+ * puts a pointer to the first change of the move in changes, and returns the number of changes in the move.
+ * NOTE: the pointer is valid only until the next change to the log
+ */
+int getMoveChanges(MoveLog * log, int isUndo, CellChange ** changes);
+
+/*
+ * sets the current move one move forward
+ */
+void setMovePointerForward(MoveLog * log);
+
+/*
+ * sets the current move one move backwards
+ */
+void setMovePointerBackward(MoveLog * log);
+
+/*
+ * return 1 iff there is a move that can be undone
+ */
+int checkUndoAvailable(MoveLog * log);
+
+/*
+ * return 1 iff there is a move that can be redone
+ */
+int checkRedoAvailable(MoveLog * log);
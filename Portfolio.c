@@ -0,0 +1,149 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "Solver.h"
+#include "Portfolio.h"
+
+/*
+ * Portfolio is the state shared by the backends of a portfolio solve:
+ * 1. lock - protects winner
+ * 2. board, m, n - the solved board (only read by the backends) and its block dimensions
+ * 3. deadline - the caller deadline (may be NULL)
+ * 4. winner - the backend with the first conclusive result, -1 until one concludes
+ */
+typedef struct Portfolio{
+	pthread_mutex_t lock;
+	int ** board;
+	int m;
+	int n;
+	SolverDeadline * deadline;
+	int winner;
+}Portfolio;
+
+/*
+ * BackendRun is a single backend of a portfolio solve:
+ * 1. portfolio - the shared state
+ * 2. backend - the backend (solverBackend)
+ * 3. solution - the backend own solution board
+ * 4. result - the backend sudokuResult
+ * 5. thread, started - the backend thread, and 1 iff it was started
+ */
+typedef struct BackendRun{
+	Portfolio * portfolio;
+	int backend;
+	int ** solution;
+	int result;
+	pthread_t thread;
+	int started;
+}BackendRun;
+
+/***** Portfolio inner functions *****/
+
+/*
+ * the stop condition of the backends (see Solver.h): returns 1 iff a backend already concluded or the deadline passed
+ */
+int isPortfolioDecided(void * arg) {
+	Portfolio * portfolio = (Portfolio *) arg;
+	int decided;
+
+	pthread_mutex_lock(&portfolio->lock);
+	decided = portfolio->winner != -1;
+	pthread_mutex_unlock(&portfolio->lock);
+	return decided || isSolverDeadlinePassed(portfolio->deadline);
+}
+
+/*
+ * run a single backend, and make it the winner if its result is the first conclusive one
+ */
+void * runBackend(void * arg) {
+	BackendRun * run = (BackendRun *) arg;
+	Portfolio * portfolio = run->portfolio;
+
+	if (run->backend == BACKEND_ILP) {
+		run->result = solveBoardWithILPWithin(portfolio->board, portfolio->m, portfolio->n,
+				isPortfolioDecided, portfolio, portfolio->deadline, run->solution);
+	}
+	else {
+		run->result = solveBoardWithBacktracking(portfolio->board, portfolio->m, portfolio->n,
+				isPortfolioDecided, portfolio, run->solution);
+	}
+
+	pthread_mutex_lock(&portfolio->lock);
+	if (portfolio->winner == -1 && (run->result == SUDOKU_OK || run->result == SUDOKU_UNSOLVABLE)) {
+		portfolio->winner = run->backend;
+	}
+	pthread_mutex_unlock(&portfolio->lock);
+	return NULL;
+}
+
+
+/***** Portfolio.h implementation *****/
+
+int solveBoardWithPortfolio(int ** board, int m, int n, SolverDeadline * deadline, int ** solution, int * winner){
+	Portfolio portfolio;
+	BackendRun runs[NUM_OF_BACKENDS];
+	int result = SUDOKU_SOLVER_ERROR;
+	int k;
+	int i;
+
+	for (k = 0; k < NUM_OF_BACKENDS; k++) {
+		runs[k].solution = createBoardSnapshot(NULL, m*n);
+		if (runs[k].solution == NULL) {
+			while (k-- > 0) {
+				freeBoardSnapshot(runs[k].solution);
+			}
+			return SUDOKU_OUT_OF_MEMORY;
+		}
+		runs[k].portfolio = &portfolio;
+		runs[k].backend = k;
+		runs[k].result = SUDOKU_STOPPED;
+		runs[k].started = 0;
+	}
+	pthread_mutex_init(&portfolio.lock, NULL);
+	portfolio.board = board;
+	portfolio.m = m;
+	portfolio.n = n;
+	portfolio.deadline = deadline;
+	portfolio.winner = -1;
+
+	/* a backend that cannot get a thread just doesn't take part in the race */
+	for (k = 0; k < NUM_OF_BACKENDS - 1; k++) {
+		runs[k].started = pthread_create(&runs[k].thread, NULL, runBackend, &runs[k]) == 0;
+	}
+	runBackend(&runs[NUM_OF_BACKENDS - 1]);
+	for (k = 0; k < NUM_OF_BACKENDS - 1; k++) {
+		if (runs[k].started == 1) {
+			pthread_join(runs[k].thread, NULL);
+		}
+	}
+
+	if (portfolio.winner != -1) {
+		result = runs[portfolio.winner].result;
+		if (result == SUDOKU_OK && solution != NULL) {
+			for (i = 0; i < m*n; i++) {
+				memcpy(solution[i], runs[portfolio.winner].solution[i], m*n*sizeof(int));
+			}
+		}
+		if (winner != NULL) {
+			*winner = portfolio.winner;
+		}
+	}
+	else {
+		for (k = 0; k < NUM_OF_BACKENDS; k++) {
+			if (runs[k].result == SUDOKU_OUT_OF_MEMORY) {
+				result = SUDOKU_OUT_OF_MEMORY;
+			}
+		}
+		if (result != SUDOKU_OUT_OF_MEMORY && isSolverDeadlinePassed(deadline) == 1) {
+			result = SUDOKU_TIMEOUT;
+		}
+	}
+
+	for (k = 0; k < NUM_OF_BACKENDS; k++) {
+		freeBoardSnapshot(runs[k].solution);
+	}
+	pthread_mutex_destroy(&portfolio.lock);
+	return result;
+}
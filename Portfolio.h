@@ -0,0 +1,39 @@
+/************************************
+* FILES NAMES :        Portfolio.c , Portfolio.h
+*
+* DESCRIPTION :
+*       Portfolio solving (part of libsudoku): the solver backends race on the same board in parallel,
+*       the first conclusive result wins and the other backends are stopped.
+*       No single backend is the fastest on every board - the ILP solver (Gurobi) and the native
+*       backtracking solver are each much faster than the other on different boards.
+*
+* PUBLIC FUNCTIONS :
+*       int solveBoardWithPortfolio(int ** board, int m, int n, SolverDeadline * deadline, int ** solution, int * winner)
+*
+* NOTES :
+*       1. Every backend runs in its own thread (the last one in the calling thread), with its own solution board,
+*          and is stopped through its stop condition (see Solver.h) once another backend concluded.
+*       2. A result is conclusive if it tells whether the board is solvable (SUDOKU_OK or SUDOKU_UNSOLVABLE).
+*          A backend that fails (for example, Gurobi isn't available) doesn't stop the others.
+*       3. All the backends share the caller deadline (see Solver.h), and are stopped once it passed.
+*       4. Like the rest of libsudoku, the portfolio never prints and never exits.
+*       5. The files that include Portfolio.h must include Solver.h before it.
+*
+************************************/
+
+/*
+ * the portfolio solver backends:
+ * 1. BACKEND_ILP - solveBoardWithILPUntil
+ * 2. BACKEND_BACKTRACKING - solveBoardWithBacktracking
+ */
+typedef enum solverBackend {
+	BACKEND_ILP, BACKEND_BACKTRACKING, NUM_OF_BACKENDS} solverBackend;
+
+/*
+ * solves the board with all the backends in parallel (see the notes above), until the deadline (NULL for no deadline).
+ * returns the first conclusive result (SUDOKU_OK, with the solution written to solution unless it is NULL,
+ * or SUDOKU_UNSOLVABLE) and puts the backend that found it in winner (unless winner is NULL).
+ * if no backend concluded - returns SUDOKU_OUT_OF_MEMORY if a backend ran out of memory, SUDOKU_TIMEOUT if the deadline passed,
+ * otherwise SUDOKU_SOLVER_ERROR
+ */
+int solveBoardWithPortfolio(int ** board, int m, int n, SolverDeadline * deadline, int ** solution, int * winner);
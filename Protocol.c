@@ -0,0 +1,311 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Game.h"
+#include "Protocol.h"
+#include "mainAux.h"
+
+/***** Protocol inner functions *****/
+
+/*
+ * appends len chars from str to the reply line
+ */
+void appendToLine(Protocol * protocol, char * str, long len) {
+	while(protocol->lineLen + len > protocol->lineCapacity) {
+		protocol->lineCapacity *= 2;
+		protocol->line = (char *) realloc(protocol->line, protocol->lineCapacity);
+		if (protocol->line == NULL){
+			printMemoryAllocationError();
+			exit(0);
+		}
+	}
+	memcpy(protocol->line + protocol->lineLen, str, len);
+	protocol->lineLen += len;
+}
+
+/*
+ * appends a null terminated string to the reply line (as is)
+ */
+void appendRaw(Protocol * protocol, char * str) {
+	appendToLine(protocol, str, strlen(str));
+}
+
+/*
+ * appends an integer to the reply line
+ */
+void appendInt(Protocol * protocol, long x) {
+	char digits[PROTOCOL_LONG_MAX_DIGITS + 2];
+
+	appendToLine(protocol, digits, sprintf(digits, "%ld", x));
+}
+
+/*
+ * appends len chars of str to the reply line as a JSON string
+ */
+void appendJsonString(Protocol * protocol, char * str, long len) {
+	long k;
+	char escaped[2];
+	char hex[7];
+
+	appendRaw(protocol, "\"");
+	for(k = 0; k < len; k++) {
+		if(str[k] == '"' || str[k] == '\\') {
+			escaped[0] = '\\';
+			escaped[1] = str[k];
+			appendToLine(protocol, escaped, 2);
+		}
+		else if((unsigned char) str[k] < 0x20) {
+			sprintf(hex, "\\u%04x", (unsigned char) str[k]);
+			appendToLine(protocol, hex, 6);
+		}
+		else {
+			appendToLine(protocol, str + k, 1);
+		}
+	}
+	appendRaw(protocol, "\"");
+}
+
+/*
+ * returns 1 iff the game has a board (a board is loaded and the game isn't over)
+ */
+int hasBoard(Game * game) {
+	return game->gameMode != INIT_MODE && game->gameOver == 0;
+}
+
+/*
+ * returns the state of a board cell: its value * 4 and its flags
+ */
+int getProtocolCellState(Game * game, int i, int j) {
+	int state = abs(game->gameBoard[i][j]) * 4;
+
+	if(game->originalBoard[i][j] != 0) {
+		state += PROTOCOL_FIXED_FLAG;
+	}
+	if(game->gameBoard[i][j] < 0) {
+		state += PROTOCOL_ERROR_FLAG;
+	}
+	return state;
+}
+
+/*
+ * appends the "size" member if the board dimensions changed since the previous command,
+ * and the "changes" member with every cell whose state changed. then keeps the board cells states
+ */
+void appendBoardChanges(Protocol * protocol, Game * game) {
+	int i;
+	int j;
+	int state;
+	int m = 0;
+	int n = 0;
+	int N;
+	int numOfChanges = 0;
+
+	if(hasBoard(game) == 1) {
+		m = game->m;
+		n = game->n;
+	}
+	N = m*n;
+
+	/* the previous states are of another board - start from an empty board */
+	if(m != protocol->m || n != protocol->n) {
+		appendRaw(protocol, ",\"size\":[");
+		appendInt(protocol, m);
+		appendRaw(protocol, ",");
+		appendInt(protocol, n);
+		appendRaw(protocol, "]");
+
+		free(protocol->cells);
+		protocol->cells = (int *) calloc((long) N*N + 1, sizeof(int));
+		if (protocol->cells == NULL){
+			printMemoryAllocationError();
+			exit(0);
+		}
+		protocol->m = m;
+		protocol->n = n;
+	}
+
+	appendRaw(protocol, ",\"changes\":[");
+	for(i = 0; i < N; i++) {
+		for(j = 0; j < N; j++) {
+			state = getProtocolCellState(game, i, j);
+			if(state == protocol->cells[i*N + j]) {
+				continue;
+			}
+			protocol->cells[i*N + j] = state;
+			if(numOfChanges++ > 0) {
+				appendRaw(protocol, ",");
+			}
+			appendRaw(protocol, "[");
+			appendInt(protocol, i+1);
+			appendRaw(protocol, ",");
+			appendInt(protocol, j+1);
+			appendRaw(protocol, ",");
+			appendInt(protocol, state / 4);
+			appendRaw(protocol, ",");
+			appendInt(protocol, state % 4);
+			appendRaw(protocol, "]");
+		}
+	}
+	appendRaw(protocol, "]");
+}
+
+/*
+ * appends the "messages" member - every line the command printed - unless it printed nothing
+ */
+void appendMessages(Protocol * protocol) {
+	long start = 0;
+	long k;
+	int numOfMessages = 0;
+
+	fflush(protocol->messages);
+	if(protocol->messagesSize == 0) {
+		return;
+	}
+
+	appendRaw(protocol, ",\"messages\":[");
+	for(k = 0; k <= (long) protocol->messagesSize; k++) {
+		if(k == (long) protocol->messagesSize || protocol->messagesBuffer[k] == '\n') {
+			if(k > start) {
+				if(numOfMessages++ > 0) {
+					appendRaw(protocol, ",");
+				}
+				appendJsonString(protocol, protocol->messagesBuffer + start, k - start);
+			}
+			start = k + 1;
+		}
+	}
+	appendRaw(protocol, "]");
+}
+
+/*
+ * appends the "board" member (the rows of cell values) and the "flags" member (the rows of cell flags)
+ */
+void appendBoard(Protocol * protocol, Game * game) {
+	int i;
+	int j;
+	int flags;
+
+	for(flags = 0; flags <= 1; flags++) {
+		appendRaw(protocol, flags == 0 ? ",\"board\":[" : ",\"flags\":[");
+		for(i = 0; i < game->N; i++) {
+			appendRaw(protocol, i == 0 ? "[" : ",[");
+			for(j = 0; j < game->N; j++) {
+				if(j > 0) {
+					appendRaw(protocol, ",");
+				}
+				if(flags == 0) {
+					appendInt(protocol, getProtocolCellState(game, i, j) / 4);
+				}
+				else {
+					appendInt(protocol, getProtocolCellState(game, i, j) % 4);
+				}
+			}
+			appendRaw(protocol, "]");
+		}
+		appendRaw(protocol, "]");
+	}
+}
+
+
+/***** Protocol.h implementation *****/
+
+void initProtocol(Protocol * protocol) {
+	protocol->messagesBuffer = NULL;
+	protocol->messagesSize = 0;
+	protocol->messages = open_memstream(&protocol->messagesBuffer, &protocol->messagesSize);
+	if (protocol->messages == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	setMessagesOutput(protocol->messages);
+
+	protocol->cells = NULL;
+	protocol->m = 0;
+	protocol->n = 0;
+	protocol->commandName[0] = '\0';
+	protocol->errorsBefore = 0;
+	protocol->startSec = 0;
+	protocol->startNsec = 0;
+
+	protocol->lineLen = 0;
+	protocol->lineCapacity = PROTOCOL_LINE_INITIAL_SIZE;
+	protocol->line = (char *) malloc(protocol->lineCapacity);
+	if (protocol->line == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+}
+
+void freeProtocol(Protocol * protocol) {
+	setMessagesOutput(NULL);
+	fclose(protocol->messages);
+	free(protocol->messagesBuffer);
+	free(protocol->cells);
+	free(protocol->line);
+}
+
+void beginProtocolCommand(Protocol * protocol, char * input) {
+	struct timespec now;
+	int len = 0;
+
+	/* the command name is the first word of the command line */
+	if(input == NULL) {
+		strcpy(protocol->commandName, EXIT_STR);
+	}
+	else {
+		input += strspn(input, DELIMITER);
+		len = strcspn(input, DELIMITER);
+		if(len > PROTOCOL_COMMAND_NAME_MAX_SIZE) {
+			len = PROTOCOL_COMMAND_NAME_MAX_SIZE;
+		}
+		memcpy(protocol->commandName, input, len);
+		protocol->commandName[len] = '\0';
+	}
+
+	/* the messages of the command are printed from the start of the messages stream */
+	fflush(protocol->messages);
+	fseek(protocol->messages, 0, SEEK_SET);
+	protocol->errorsBefore = getNumOfPrintedErrors();
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	protocol->startSec = (long) now.tv_sec;
+	protocol->startNsec = now.tv_nsec;
+}
+
+void endProtocolCommand(Protocol * protocol, Game * game, int withBoard) {
+	struct timespec now;
+	long elapsedUs;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	elapsedUs = ((long) now.tv_sec - protocol->startSec) * 1000000L +
+			(now.tv_nsec - protocol->startNsec) / 1000;
+
+	protocol->lineLen = 0;
+	appendRaw(protocol, "{\"cmd\":");
+	appendJsonString(protocol, protocol->commandName, strlen(protocol->commandName));
+	if(getNumOfPrintedErrors() > protocol->errorsBefore) {
+		appendRaw(protocol, ",\"status\":\"error\"");
+	}
+	else {
+		appendRaw(protocol, ",\"status\":\"ok\"");
+	}
+	appendRaw(protocol, ",\"time_us\":");
+	appendInt(protocol, elapsedUs);
+	appendRaw(protocol, ",\"mode\":\"");
+	appendRaw(protocol, hasBoard(game) == 0 ? "init" : game->gameMode == SOLVE_MODE ? "solve" : "edit");
+	appendRaw(protocol, "\"");
+
+	appendBoardChanges(protocol, game);
+	appendMessages(protocol);
+	if(withBoard == 1 && hasBoard(game) == 1) {
+		appendBoard(protocol, game);
+	}
+	appendRaw(protocol, "}\n");
+
+	/* one write per reply, and the driver gets it at once */
+	fwrite(protocol->line, 1, protocol->lineLen, getOutput());
+	fflush(getOutput());
+}
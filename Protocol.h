@@ -0,0 +1,96 @@
+/************************************
+* FILES NAMES :        Protocol.c , Protocol.h
+*
+* DESCRIPTION :
+*       JSON lines protocol mode - a machine readable reply for every command.
+*       Instead of the user messages and the printed board, every command produces a single JSON line.
+*
+* PUBLIC FUNCTIONS :
+*       void initProtocol(Protocol * protocol)
+*       void freeProtocol(Protocol * protocol)
+*       void beginProtocolCommand(Protocol * protocol, char * input)
+*       void endProtocolCommand(Protocol * protocol, Game * game, int withBoard)
+*
+* NOTES :
+*       1. Every reply line is a JSON object with the following members:
+*           a. "cmd" - the command name as typed (the first word of the command line, "exit" at the end of the input).
+*           b. "status" - "ok", or "error" if the command printed an error message.
+*           c. "time_us" - the command execution time in microseconds.
+*           d. "mode" - the game mode after the command: "init", "edit" or "solve" ("init" once the game is over).
+*           e. "size" - [m, n], only if the board dimensions changed (or the board was loaded or closed) -
+*              [0, 0] when there is no board.
+*           f. "changes" - the cells whose state changed during the command: [row, col, value, flags] each,
+*              rows and columns are 1-based, value is 0 for an empty cell,
+*              flags bit 0 is set for a fixed cell and bit 1 for an erroneous cell.
+*              after a "size" member, the changes are relative to an empty board.
+*           g. "messages" - the user messages the command printed, one string per line (omitted if empty).
+*           h. "board" - only when requested (print_board): the rows of cell values,
+*              followed by "flags" - the rows of the cells flags.
+*       2. The changes are found by comparing the board with a copy of it taken after the previous command.
+*       3. Every line is flushed, so a driver can wait for the reply of each command.
+*
+************************************/
+
+/* max length of the command name in a reply */
+#define PROTOCOL_COMMAND_NAME_MAX_SIZE 32
+
+/* initial size of the reply line buffer */
+#define PROTOCOL_LINE_INITIAL_SIZE 4096
+
+/* max number of digits of a long (an upper bound: 3 digits per byte) */
+#define PROTOCOL_LONG_MAX_DIGITS (3 * (int) sizeof(long))
+
+/* cell flags in replies */
+#define PROTOCOL_FIXED_FLAG 1
+#define PROTOCOL_ERROR_FLAG 2
+
+/*
+ * Protocol holds the protocol mode state between commands:
+ * 1. messages, messagesBuffer, messagesSize - the in-memory stream the user messages are printed to
+ * 2. cells, m, n - the state of every board cell after the previous command (value * 4 + flags),
+ *    and the board dimensions (0 if there was no board)
+ * 3. commandName - the name of the current command
+ * 4. errorsBefore - the number of error messages that were printed before the current command
+ * 5. startSec, startNsec - the current command start time
+ * 6. line, lineLen, lineCapacity - the reply line buffer
+ */
+typedef struct Protocol{
+	FILE * messages;
+	char * messagesBuffer;
+	size_t messagesSize;
+
+	int * cells;
+	int m;
+	int n;
+
+	char commandName[PROTOCOL_COMMAND_NAME_MAX_SIZE + 1];
+	int errorsBefore;
+	long startSec;
+	long startNsec;
+
+	char * line;
+	long lineLen;
+	long lineCapacity;
+}Protocol;
+
+/*
+ * initialize the protocol state and print all the user messages to its messages stream
+ */
+void initProtocol(Protocol * protocol);
+
+/*
+ * print the user messages to the output again and free the protocol state
+ */
+void freeProtocol(Protocol * protocol);
+
+/*
+ * starts a command: gets the command line as typed (NULL at the end of the input),
+ * keeps the command name, and starts the command timer
+ */
+void beginProtocolCommand(Protocol * protocol, char * input);
+
+/*
+ * ends the command: prints the command reply line (see NOTES).
+ * the board is included in the reply iff withBoard is 1 and the game has a board
+ */
+void endProtocolCommand(Protocol * protocol, Game * game, int withBoard);
@@ -0,0 +1,342 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "Solver.h"
+#include "Portfolio.h"
+#include "PuzzleGenerator.h"
+#include "Random.h"
+#include "BoardFile.h"
+#include "PuzzleBatch.h"
+#include "mainAux.h"
+
+/*
+ * PuzzleBatch is the state shared by the producers and the writer of a batch:
+ * 1. lock - protects all the fields below the generate parameters
+ * 2. slotFilled - signaled when a producer put a puzzle in a slot (the writer waits on it)
+ * 3. slotFreed - signaled when the writer took a puzzle out of its slot (the producers wait on it)
+ * 4. m, n, count, x, y, seed, maxAttempts, deadline - the generate parameters
+ * 5. slots, isSlotFilled, numOfSlots - the queue: puzzle number k is put in slots[k % numOfSlots]
+ * 6. nextPuzzle - the number of the next puzzle a producer takes
+ * 7. numOfWritten - the number of puzzles the writer took out of the queue
+ * 8. result - SUDOKU_OK, or the sudokuResult of the first puzzle that failed
+ * 		(the writer stops the batch with SUDOKU_OK when the file cannot be written)
+ * 9. stopped - 1 iff the batch failed, so the producers and the writer stop
+ */
+typedef struct PuzzleBatch{
+	pthread_mutex_t lock;
+	pthread_cond_t slotFilled;
+	pthread_cond_t slotFreed;
+	int m;
+	int n;
+	int count;
+	int x;
+	int y;
+	unsigned long seed;
+	int maxAttempts;
+	SolverDeadline * deadline;
+	int *** slots;
+	int * isSlotFilled;
+	int numOfSlots;
+	int nextPuzzle;
+	int numOfWritten;
+	int result;
+	int stopped;
+}PuzzleBatch;
+
+/***** PuzzleBatch inner functions *****/
+
+/*
+ * returns the seconds that passed since start
+ */
+double getSecondsSince(struct timespec * start) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double) (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/*
+ * stops the batch with the given result (the first failure is kept)
+ * NOTE: the caller holds the batch lock
+ */
+void stopBatch(PuzzleBatch * batch, int result) {
+	if (batch->stopped == 0) {
+		batch->stopped = 1;
+		batch->result = result;
+	}
+	pthread_cond_broadcast(&batch->slotFilled);
+	pthread_cond_broadcast(&batch->slotFreed);
+}
+
+/*
+ * the producer thread: generates the next puzzle, waits for its slot and puts it there,
+ * until all the puzzles were taken or the batch stopped
+ */
+void * runBatchProducer(void * arg) {
+	PuzzleBatch * batch = (PuzzleBatch *) arg;
+	int N = batch->m * batch->n;
+	int ** puzzle = createBoardSnapshot(NULL, N);
+	int ** solution = createBoardSnapshot(NULL, N);
+	int ** slot;
+	int result;
+	int k;
+	int i;
+
+	if (puzzle == NULL || solution == NULL) {
+		pthread_mutex_lock(&batch->lock);
+		stopBatch(batch, SUDOKU_OUT_OF_MEMORY);
+		pthread_mutex_unlock(&batch->lock);
+	}
+
+	while (1) {
+		pthread_mutex_lock(&batch->lock);
+		if (batch->stopped == 1 || batch->nextPuzzle >= batch->count) {
+			pthread_mutex_unlock(&batch->lock);
+			break;
+		}
+		k = batch->nextPuzzle++;
+		pthread_mutex_unlock(&batch->lock);
+
+		result = generatePuzzleWithin(batch->m, batch->n, batch->x, batch->y,
+				(batch->seed + (unsigned long) k * RANDOM_SEED_INCREMENT) & RANDOM_WORD_MASK,
+				batch->maxAttempts, 1, BACKEND_BACKTRACKING, batch->deadline, puzzle, solution, NULL);
+
+		pthread_mutex_lock(&batch->lock);
+		if (result != SUDOKU_OK) {
+			stopBatch(batch, result);
+			pthread_mutex_unlock(&batch->lock);
+			break;
+		}
+		/* the writer frees the slot once it took puzzle k - numOfSlots */
+		while (batch->stopped == 0 && k >= batch->numOfWritten + batch->numOfSlots) {
+			pthread_cond_wait(&batch->slotFreed, &batch->lock);
+		}
+		if (batch->stopped == 1) {
+			pthread_mutex_unlock(&batch->lock);
+			break;
+		}
+		slot = batch->slots[k % batch->numOfSlots];
+		for (i = 0; i < N; i++) {
+			memcpy(slot[i], puzzle[i], N*sizeof(int));
+		}
+		batch->isSlotFilled[k % batch->numOfSlots] = 1;
+		pthread_cond_broadcast(&batch->slotFilled);
+		pthread_mutex_unlock(&batch->lock);
+	}
+
+	freeBoardSnapshot(puzzle);
+	freeBoardSnapshot(solution);
+	return NULL;
+}
+
+/*
+ * the writer: takes the puzzles out of the queue in order and streams them to the open pack file fd,
+ * printing the progress. returns 1 iff all the puzzles were written
+ */
+int writeBatchPuzzles(PuzzleBatch * batch, int fd, struct timespec * start) {
+	int N = batch->m * batch->n;
+	long puzzleSize = getPackedPuzzleSize(N);
+	unsigned char * buffer;
+	long bufferLen = 0;
+	long bufferSize = puzzleSize > BATCH_WRITE_BUFFER_SIZE ? puzzleSize : BATCH_WRITE_BUFFER_SIZE;
+	int progressStep = batch->count / BATCH_PROGRESS_STEPS;
+	int success;
+	int k;
+
+	buffer = (unsigned char *) malloc(bufferSize);
+	if (buffer == NULL) {
+		printMemoryAllocationError();
+		exit(0);
+	}
+	if (progressStep == 0) {
+		progressStep = 1;
+	}
+
+	/* the header is written again with the final count once the pack is complete */
+	formatPuzzlePackHeader(buffer, batch->m, batch->n, 0);
+	bufferLen = PUZZLE_PACK_HEADER_SIZE;
+
+	for (k = 0; k < batch->count; k++) {
+		pthread_mutex_lock(&batch->lock);
+		while (batch->stopped == 0 && batch->isSlotFilled[k % batch->numOfSlots] == 0) {
+			pthread_cond_wait(&batch->slotFilled, &batch->lock);
+		}
+		if (batch->stopped == 1) {
+			pthread_mutex_unlock(&batch->lock);
+			free(buffer);
+			return 0;
+		}
+		pthread_mutex_unlock(&batch->lock);
+
+		/* the slot isn't reused before it is freed, so it is read without the lock */
+		if (bufferLen + puzzleSize > bufferSize) {
+			if (writeAll(fd, buffer, bufferLen) == 0) {
+				pthread_mutex_lock(&batch->lock);
+				stopBatch(batch, SUDOKU_OK);
+				pthread_mutex_unlock(&batch->lock);
+				free(buffer);
+				return 0;
+			}
+			bufferLen = 0;
+		}
+		formatPackedPuzzle(buffer + bufferLen, batch->slots[k % batch->numOfSlots], N);
+		bufferLen += puzzleSize;
+
+		pthread_mutex_lock(&batch->lock);
+		batch->isSlotFilled[k % batch->numOfSlots] = 0;
+		batch->numOfWritten++;
+		pthread_cond_broadcast(&batch->slotFreed);
+		pthread_mutex_unlock(&batch->lock);
+
+		if ((k + 1) % progressStep == 0 && k + 1 < batch->count) {
+			printBatchProgress(k + 1, batch->count, getSecondsSince(start));
+		}
+	}
+
+	if (writeAll(fd, buffer, bufferLen) == 0) {
+		free(buffer);
+		return 0;
+	}
+	formatPuzzlePackHeader(buffer, batch->m, batch->n, batch->count);
+	success = lseek(fd, 0, SEEK_SET) == 0 && writeAll(fd, buffer, PUZZLE_PACK_HEADER_SIZE);
+	free(buffer);
+	return success;
+}
+
+/*
+ * allocates the batch queue slots. returns 0 if a memory allocation failed
+ * (the allocated slots are freed by freeBatchSlots)
+ */
+int initBatchSlots(PuzzleBatch * batch, int numOfSlots) {
+	int N = batch->m * batch->n;
+	int k;
+
+	batch->numOfSlots = numOfSlots;
+	batch->slots = (int ***) calloc(numOfSlots, sizeof(int **));
+	batch->isSlotFilled = (int *) calloc(numOfSlots, sizeof(int));
+	if (batch->slots == NULL || batch->isSlotFilled == NULL) {
+		return 0;
+	}
+	for (k = 0; k < numOfSlots; k++) {
+		batch->slots[k] = createBoardSnapshot(NULL, N);
+		if (batch->slots[k] == NULL) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * frees the batch queue slots
+ */
+void freeBatchSlots(PuzzleBatch * batch) {
+	int k;
+
+	if (batch->slots != NULL) {
+		for (k = 0; k < batch->numOfSlots; k++) {
+			freeBoardSnapshot(batch->slots[k]);
+		}
+	}
+	free(batch->slots);
+	free(batch->isSlotFilled);
+}
+
+
+/***** PuzzleBatch.h implementation *****/
+
+int generatePuzzleBatch(int m, int n, int count, int x, int y, unsigned long seed, int maxAttempts, int numOfProducers,
+		SolverDeadline * deadline, char * filePath) {
+	PuzzleBatch batch;
+	pthread_t producers[MAX_GENERATE_WORKERS];
+	int isStarted[MAX_GENERATE_WORKERS];
+	struct timespec start;
+	char * tempPath;
+	int fd;
+	int written;
+	int numOfStarted = 0;
+	int k;
+
+	if (numOfProducers > MAX_GENERATE_WORKERS) {
+		numOfProducers = MAX_GENERATE_WORKERS;
+	}
+	if (numOfProducers < 1) {
+		numOfProducers = 1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	batch.m = m;
+	batch.n = n;
+	batch.count = count;
+	batch.x = x;
+	batch.y = y;
+	batch.seed = seed;
+	batch.maxAttempts = maxAttempts;
+	batch.deadline = deadline;
+	batch.nextPuzzle = 0;
+	batch.numOfWritten = 0;
+	batch.result = SUDOKU_OK;
+	batch.stopped = 0;
+	if (initBatchSlots(&batch, numOfProducers * BATCH_SLOTS_PER_PRODUCER) == 0) {
+		printMemoryAllocationError();
+		exit(0);
+	}
+
+	fd = openTempFile(filePath, &tempPath);
+	if (fd < 0) {
+		freeBatchSlots(&batch);
+		printFileCreationError();
+		return 0;
+	}
+
+	pthread_mutex_init(&batch.lock, NULL);
+	pthread_cond_init(&batch.slotFilled, NULL);
+	pthread_cond_init(&batch.slotFreed, NULL);
+
+	/* a producer that cannot get a thread just doesn't take part, but at least one is needed */
+	for (k = 0; k < numOfProducers; k++) {
+		isStarted[k] = pthread_create(&producers[k], NULL, runBatchProducer, &batch) == 0;
+		numOfStarted += isStarted[k];
+	}
+	if (numOfStarted == 0) {
+		batch.result = SUDOKU_OUT_OF_MEMORY;
+		written = 0;
+	}
+	else {
+		written = writeBatchPuzzles(&batch, fd, &start);
+	}
+	for (k = 0; k < numOfProducers; k++) {
+		if (isStarted[k] == 1) {
+			pthread_join(producers[k], NULL);
+		}
+	}
+
+	pthread_mutex_destroy(&batch.lock);
+	pthread_cond_destroy(&batch.slotFilled);
+	pthread_cond_destroy(&batch.slotFreed);
+	freeBatchSlots(&batch);
+
+	written = commitTempFile(fd, tempPath, filePath, written);
+	if (batch.result == SUDOKU_OUT_OF_MEMORY) {
+		printMemoryAllocationError();
+		exit(0);
+	}
+	if (batch.result == SUDOKU_TIMEOUT) {
+		printBatchTimeLimitReachedError(batch.numOfWritten, count, getSecondsSince(&start));
+		return 0;
+	}
+	if (batch.result != SUDOKU_OK) {
+		printPuzzleGeneratorFailedError();
+		return 0;
+	}
+	if (written == 0) {
+		printFileCreationError();
+		return 0;
+	}
+	printBatchGenerated(count, filePath, getSecondsSince(&start));
+	return 1;
+}
@@ -0,0 +1,49 @@
+/************************************
+* FILES NAMES :        PuzzleBatch.c , PuzzleBatch.h
+*
+* DESCRIPTION :
+*       Bulk puzzle generation (the generate_batch command): producer threads generate puzzles,
+*       and a writer streams them, in order, to a puzzle pack file (see BoardFile.h) through a bounded queue.
+*
+* PUBLIC FUNCTIONS :
+*       int generatePuzzleBatch(int m, int n, int count, int x, int y, unsigned long seed, int maxAttempts, int numOfProducers,
+*               SolverDeadline * deadline, char * filePath)
+*
+* NOTES :
+*       1. The calling thread is the writer, and the caller chooses the number of producers (at most MAX_GENERATE_WORKERS,
+*          see PuzzleGenerator.h): a producer per online processor, or a single one when the batch runs on a server worker.
+*       2. The queue is a ring of slots: puzzle number k is put in slot k % (number of slots),
+*          and a producer waits until the writer freed that slot. The writer takes the puzzles in order,
+*          so the pack holds the puzzles in order of their numbers, and the queue memory is bounded
+*          however slow the file is.
+*       3. Puzzle number k is generated with its own seed (derived from seed and k),
+*          so a batch with the same seed writes the same pack file.
+*       4. Each puzzle is generated like the generate command, but solved with the native backtracking solver
+*          (a new ILP model per puzzle is too slow for a batch).
+*       5. The writer prints the progress once every BATCH_PROGRESS_STEPS-th of the batch,
+*          and the pack file replaces the target file only once all the puzzles were written.
+*       6. The whole batch is bounded by a deadline (see Solver.h): the producers generate within it,
+*          and a producer that reaches it stops the batch, so the target file is left untouched.
+*       7. The files that include PuzzleBatch.h must include Solver.h before it.
+*
+************************************/
+
+/* number of queue slots per producer */
+#define BATCH_SLOTS_PER_PRODUCER 4
+
+/* the progress is printed BATCH_PROGRESS_STEPS times during a batch */
+#define BATCH_PROGRESS_STEPS 10
+
+/* size of the writer buffer */
+#define BATCH_WRITE_BUFFER_SIZE 65536
+
+/*
+ * generates count puzzles of N*N boards (N = m*n, blocks of m rows and n columns),
+ * each like generate X Y with at most maxAttempts attempts, on numOfProducers producer threads (1 to MAX_GENERATE_WORKERS),
+ * and writes them to a puzzle pack in filePath.
+ * the batch is stopped once the deadline passed (deadline may be NULL - no deadline).
+ * the progress, and at the end the number of puzzles and the throughput (or the time limit error), are printed.
+ * returns 1 iff the pack file was written (otherwise an error is printed and the file in filePath is untouched)
+ */
+int generatePuzzleBatch(int m, int n, int count, int x, int y, unsigned long seed, int maxAttempts, int numOfProducers,
+		SolverDeadline * deadline, char * filePath);
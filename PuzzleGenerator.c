@@ -0,0 +1,436 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "Solver.h"
+#include "Random.h"
+#include "Portfolio.h"
+#include "PuzzleGenerator.h"
+
+/*
+ * Generation is the state shared by the workers of a generate command:
+ * 1. lock - protects nextAttempt, the first attempt numbers and the winner
+ * 2. m, n, x, y, seed, maxAttempts, backend, deadline - the generate parameters
+ * 		and maxStopChecks - the number of stop checks after which an attempt gives up (0 for no limit)
+ * 3. nextAttempt - the number of the next attempt to start
+ * 4. firstSuccess, firstError - the lowest number of an attempt that succeeded / failed with an error
+ * 		(maxAttempts if there is no such attempt)
+ * 5. error - the sudokuResult of the attempt firstError
+ * 6. winner - the worker that ran the attempt firstSuccess
+ */
+typedef struct Generation{
+	pthread_mutex_t lock;
+	int m;
+	int n;
+	int x;
+	int y;
+	unsigned long seed;
+	int maxAttempts;
+	int backend;
+	SolverDeadline * deadline;
+	int maxStopChecks;
+	int nextAttempt;
+	int firstSuccess;
+	int firstError;
+	int error;
+	int winner;
+}Generation;
+
+/*
+ * GenerateWorker is a single worker of a generate command:
+ * 1. generation - the shared state
+ * 2. id - the worker number
+ * 3. board, puzzle, solution - the worker own boards
+ * 4. cellsArray, valuesArray - the worker own arrays of the cell numbers and the values to shuffle
+ * 5. attempt - the attempt the worker is running (its solver is stopped once a lower attempt concluded),
+ * 		and numOfStopChecks - the number of stop checks of the attempt so far
+ * 6. thread, started - the worker thread, and 1 iff it was started
+ */
+typedef struct GenerateWorker{
+	Generation * generation;
+	int id;
+	int ** board;
+	int ** puzzle;
+	int ** solution;
+	int * cellsArray;
+	int * valuesArray;
+	int attempt;
+	int numOfStopChecks;
+	pthread_t thread;
+	int started;
+}GenerateWorker;
+
+/***** PuzzleGenerator inner functions *****/
+
+/*
+ * returns 1 iff value doesn't appear in the row, the column or the block of cell <row,col> of the board
+ */
+int isLegalPlacement(int ** board, int m, int n, int row, int col, int value) {
+	int k;
+	int N = m*n;
+	int blockRow = row - row % m;
+	int blockCol = col - col % n;
+
+	for (k = 0; k < N; k++) {
+		if (board[row][k] == value || board[k][col] == value ||
+				board[blockRow + k / n][blockCol + k % n] == value) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * the stop condition of the worker solver (see Solver.h):
+ * returns 1 iff a lower attempt than the worker attempt already concluded, the attempt ran out of stop checks
+ * or the generation deadline passed
+ */
+int isAttemptOutdated(void * arg) {
+	GenerateWorker * worker = (GenerateWorker *) arg;
+	Generation * generation = worker->generation;
+	int outdated;
+
+	/* a backtracking attempt that ran out of steps gives up */
+	if (generation->maxStopChecks > 0 && ++worker->numOfStopChecks > generation->maxStopChecks) {
+		return 1;
+	}
+	if (isSolverDeadlinePassed(generation->deadline) == 1) {
+		return 1;
+	}
+	pthread_mutex_lock(&generation->lock);
+	outdated = generation->firstSuccess < worker->attempt || generation->firstError < worker->attempt;
+	pthread_mutex_unlock(&generation->lock);
+	return outdated;
+}
+
+/*
+ * runs a single generate attempt on the worker boards:
+ * fills x random cells with random legal values, solves the board with the generation solver backend
+ * and keeps y random cells of the solution in the worker puzzle.
+ * returns SUDOKU_OK iff the attempt succeeded (otherwise the sudokuResult of the failure, SUDOKU_UNSOLVABLE if
+ * a chosen cell has no legal value or the board has no solution, SUDOKU_STOPPED if the solver was stopped)
+ */
+int runGenerateAttempt(GenerateWorker * worker) {
+	Generation * generation = worker->generation;
+	RandomGenerator rng;
+	int m = generation->m;
+	int n = generation->n;
+	int N = m*n;
+	int i;
+	int v;
+	int r;
+	int c;
+	int result;
+
+	/* the arrays are shuffled from the same order in every attempt, whichever attempts the worker ran before */
+	seedRandomStream(&rng, generation->seed, (unsigned long) worker->attempt);
+	worker->numOfStopChecks = 0;
+	for (i = 0; i < N*N; i++) {
+		worker->cellsArray[i] = i;
+	}
+	for (i = 0; i < N; i++) {
+		worker->valuesArray[i] = i + 1;
+		memset(worker->board[i], 0, N*sizeof(int));
+		memset(worker->puzzle[i], 0, N*sizeof(int));
+	}
+
+	/* fill each of the first x cells of the shuffled cells with the first legal value of the shuffled values */
+	shuffleArray(&rng, worker->cellsArray, N*N);
+	for (i = 0; i < generation->x; i++) {
+		r = worker->cellsArray[i] / N;
+		c = worker->cellsArray[i] % N;
+		shuffleArray(&rng, worker->valuesArray, N);
+		for (v = 0; v < N; v++) {
+			if (isLegalPlacement(worker->board, m, n, r, c, worker->valuesArray[v]) == 1) {
+				worker->board[r][c] = worker->valuesArray[v];
+				break;
+			}
+		}
+		if (v == N) {
+			return SUDOKU_UNSOLVABLE;
+		}
+	}
+
+	if (generation->backend == BACKEND_BACKTRACKING) {
+		result = solveBoardWithBacktracking(worker->board, m, n, isAttemptOutdated, worker, worker->solution);
+	}
+	else {
+		result = solveBoardWithILPWithin(worker->board, m, n, isAttemptOutdated, worker, generation->deadline,
+				worker->solution);
+	}
+	if (result != SUDOKU_OK) {
+		return result;
+	}
+
+	/* keep y random cells of the solution */
+	shuffleArray(&rng, worker->cellsArray, N*N);
+	for (i = 0; i < generation->y; i++) {
+		r = worker->cellsArray[i] / N;
+		c = worker->cellsArray[i] % N;
+		worker->puzzle[r][c] = worker->solution[r][c];
+	}
+	return SUDOKU_OK;
+}
+
+/*
+ * the worker thread: runs attempts, in order of their numbers, until its own attempt succeeded,
+ * a lower attempt concluded, the deadline passed or there are no more attempts
+ */
+void * runGenerateWorker(void * arg) {
+	GenerateWorker * worker = (GenerateWorker *) arg;
+	Generation * generation = worker->generation;
+	int result;
+
+	while (1) {
+		pthread_mutex_lock(&generation->lock);
+		if (generation->nextAttempt >= generation->maxAttempts ||
+				generation->nextAttempt > generation->firstSuccess ||
+				generation->nextAttempt > generation->firstError ||
+				isSolverDeadlinePassed(generation->deadline) == 1) {
+			pthread_mutex_unlock(&generation->lock);
+			return NULL;
+		}
+		worker->attempt = generation->nextAttempt++;
+		pthread_mutex_unlock(&generation->lock);
+
+		result = runGenerateAttempt(worker);
+
+		pthread_mutex_lock(&generation->lock);
+		if (result == SUDOKU_OK && worker->attempt < generation->firstSuccess) {
+			generation->firstSuccess = worker->attempt;
+			generation->winner = worker->id;
+		}
+		else if ((result == SUDOKU_SOLVER_ERROR || result == SUDOKU_OUT_OF_MEMORY) &&
+				worker->attempt < generation->firstError) {
+			generation->firstError = worker->attempt;
+			generation->error = result;
+		}
+		pthread_mutex_unlock(&generation->lock);
+
+		/* the worker next attempts would have higher numbers */
+		if (result == SUDOKU_OK) {
+			return NULL;
+		}
+	}
+}
+
+/*
+ * fills lines with a random order of the numOfGroups*groupSize lines that keeps the groups of groupSize
+ * consecutive lines together: the groups are shuffled, and so are the lines within every group.
+ * groups is an array of numOfGroups ints for the groups order
+ */
+void shuffleGroupedLines(RandomGenerator * rng, int * lines, int * groups, int numOfGroups, int groupSize) {
+	int g;
+	int i;
+
+	for (g = 0; g < numOfGroups; g++) {
+		groups[g] = g;
+	}
+	shuffleArray(rng, groups, numOfGroups);
+	for (g = 0; g < numOfGroups; g++) {
+		for (i = 0; i < groupSize; i++) {
+			lines[g*groupSize + i] = groups[g]*groupSize + i;
+		}
+		shuffleArray(rng, lines + g*groupSize, groupSize);
+	}
+}
+
+/*
+ * allocates the worker boards and arrays. returns 0 if a memory allocation failed
+ * (the allocated memory is freed by freeGenerateWorker)
+ */
+int initGenerateWorker(GenerateWorker * worker, Generation * generation, int id) {
+	int N = generation->m * generation->n;
+
+	worker->generation = generation;
+	worker->id = id;
+	worker->started = 0;
+	worker->board = createBoardSnapshot(NULL, N);
+	worker->puzzle = createBoardSnapshot(NULL, N);
+	worker->solution = createBoardSnapshot(NULL, N);
+	worker->cellsArray = (int *) malloc((long) N*N*sizeof(int));
+	worker->valuesArray = (int *) malloc(N*sizeof(int));
+	if (worker->board == NULL || worker->puzzle == NULL || worker->solution == NULL ||
+			worker->cellsArray == NULL || worker->valuesArray == NULL) {
+		return 0;
+	}
+	return 1;
+}
+
+/*
+ * frees the worker boards and arrays
+ */
+void freeGenerateWorker(GenerateWorker * worker) {
+	freeBoardSnapshot(worker->board);
+	freeBoardSnapshot(worker->puzzle);
+	freeBoardSnapshot(worker->solution);
+	free(worker->cellsArray);
+	free(worker->valuesArray);
+}
+
+
+/***** PuzzleGenerator.h implementation *****/
+
+int generatePuzzle(int m, int n, int x, int y, unsigned long seed, int maxAttempts, int numOfWorkers, int backend,
+		int ** puzzle, int ** solution){
+	return generatePuzzleWithin(m, n, x, y, seed, maxAttempts, numOfWorkers, backend, NULL, puzzle, solution, NULL);
+}
+
+int generatePuzzleWithin(int m, int n, int x, int y, unsigned long seed, int maxAttempts, int numOfWorkers, int backend,
+		SolverDeadline * deadline, int ** puzzle, int ** solution, int * numOfAttempts){
+	Generation generation;
+	GenerateWorker workers[MAX_GENERATE_WORKERS];
+	int allocated = 1;
+	int result;
+	int N = m*n;
+	int k;
+	int i;
+
+	if (N >= PATTERN_GENERATE_MIN_N) {
+		if (numOfAttempts != NULL) {
+			*numOfAttempts = 1;
+		}
+		return generatePatternPuzzle(m, n, y, seed, puzzle, solution);
+	}
+	if (numOfWorkers > MAX_GENERATE_WORKERS) {
+		numOfWorkers = MAX_GENERATE_WORKERS;
+	}
+	if (numOfWorkers < 1) {
+		numOfWorkers = 1;
+	}
+	generation.m = m;
+	generation.n = n;
+	generation.x = x;
+	generation.y = y;
+	generation.seed = seed;
+	generation.maxAttempts = maxAttempts;
+	generation.backend = backend;
+	generation.deadline = deadline;
+	generation.maxStopChecks = 0;
+	if (backend == BACKEND_BACKTRACKING) {
+		generation.maxStopChecks = (int) ((long) N*N*GENERATE_MAX_STEPS_PER_CELL / SOLVER_STOP_CHECK_INTERVAL) + 1;
+	}
+	generation.nextAttempt = 0;
+	generation.firstSuccess = maxAttempts;
+	generation.firstError = maxAttempts;
+	generation.error = SUDOKU_OK;
+	generation.winner = -1;
+
+	for (k = 0; k < numOfWorkers; k++) {
+		if (initGenerateWorker(&workers[k], &generation, k) == 0) {
+			allocated = 0;
+		}
+	}
+	if (allocated == 0) {
+		for (k = 0; k < numOfWorkers; k++) {
+			freeGenerateWorker(&workers[k]);
+		}
+		return SUDOKU_OUT_OF_MEMORY;
+	}
+	pthread_mutex_init(&generation.lock, NULL);
+
+	/* the calling thread is the first worker, a worker that cannot get a thread just doesn't take part */
+	for (k = 1; k < numOfWorkers; k++) {
+		workers[k].started = pthread_create(&workers[k].thread, NULL, runGenerateWorker, &workers[k]) == 0;
+	}
+	runGenerateWorker(&workers[0]);
+	for (k = 1; k < numOfWorkers; k++) {
+		if (workers[k].started == 1) {
+			pthread_join(workers[k].thread, NULL);
+		}
+	}
+
+	if (numOfAttempts != NULL) {
+		*numOfAttempts = generation.winner == -1 ? generation.nextAttempt : generation.firstSuccess + 1;
+	}
+	if (generation.firstError < generation.firstSuccess) {
+		result = generation.error;
+	}
+	else if (generation.winner == -1) {
+		result = isSolverDeadlinePassed(deadline) == 1 ? SUDOKU_TIMEOUT : SUDOKU_UNSOLVABLE;
+	}
+	else {
+		result = SUDOKU_OK;
+		for (i = 0; i < N; i++) {
+			memcpy(puzzle[i], workers[generation.winner].puzzle[i], N*sizeof(int));
+			memcpy(solution[i], workers[generation.winner].solution[i], N*sizeof(int));
+		}
+	}
+
+	for (k = 0; k < numOfWorkers; k++) {
+		freeGenerateWorker(&workers[k]);
+	}
+	pthread_mutex_destroy(&generation.lock);
+	return result;
+}
+
+int generatePatternPuzzle(int m, int n, int y, unsigned long seed, int ** puzzle, int ** solution){
+	RandomGenerator rng;
+	int N = m*n;
+	int * rows = (int *) malloc(N*sizeof(int));
+	int * cols = (int *) malloc(N*sizeof(int));
+	int * values = (int *) malloc(N*sizeof(int));
+	int * groups = (int *) malloc(N*sizeof(int));
+	int * cells = (int *) malloc((long) N*N*sizeof(int));
+	int i;
+	int j;
+
+	if (rows == NULL || cols == NULL || values == NULL || groups == NULL || cells == NULL) {
+		free(rows);
+		free(cols);
+		free(values);
+		free(groups);
+		free(cells);
+		return SUDOKU_OUT_OF_MEMORY;
+	}
+	seedRandom(&rng, seed);
+
+	/* the bands are n groups of m rows, and the stacks are m groups of n columns */
+	shuffleGroupedLines(&rng, rows, groups, n, m);
+	shuffleGroupedLines(&rng, cols, groups, m, n);
+	for (i = 0; i < N; i++) {
+		values[i] = i + 1;
+	}
+	shuffleArray(&rng, values, N);
+
+	/* cell <i,j> of the randomized grid is cell <rows[i],cols[j]> of the pattern grid, relabeled */
+	for (i = 0; i < N; i++) {
+		for (j = 0; j < N; j++) {
+			solution[i][j] = values[((rows[i] % m) * n + rows[i] / m + cols[j]) % N];
+			puzzle[i][j] = 0;
+		}
+	}
+
+	/* keep y random cells of the grid */
+	for (i = 0; i < N*N; i++) {
+		cells[i] = i;
+	}
+	shuffleArray(&rng, cells, N*N);
+	for (i = 0; i < y; i++) {
+		puzzle[cells[i] / N][cells[i] % N] = solution[cells[i] / N][cells[i] % N];
+	}
+
+	free(rows);
+	free(cols);
+	free(values);
+	free(groups);
+	free(cells);
+	return SUDOKU_OK;
+}
+
+int getNumOfGenerateWorkers(){
+	long numOfProcessors = 1;
+
+#ifdef _SC_NPROCESSORS_ONLN
+	numOfProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (numOfProcessors < 1) {
+		return 1;
+	}
+	if (numOfProcessors > MAX_GENERATE_WORKERS) {
+		return MAX_GENERATE_WORKERS;
+	}
+	return (int) numOfProcessors;
+}
@@ -0,0 +1,87 @@
+/************************************
+* FILES NAMES :        PuzzleGenerator.c , PuzzleGenerator.h
+*
+* DESCRIPTION :
+*       Puzzle generation (part of libsudoku): the generate command attempts - randomly fill X cells with legal values,
+*       solve the board and keep Y random cells of the solution - run in parallel on several worker threads.
+*
+* PUBLIC FUNCTIONS :
+*       int generatePuzzle(int m, int n, int x, int y, unsigned long seed, int maxAttempts, int numOfWorkers, int backend,
+*                          int ** puzzle, int ** solution)
+*       int generatePuzzleWithin(int m, int n, int x, int y, unsigned long seed, int maxAttempts, int numOfWorkers, int backend,
+*                                SolverDeadline * deadline, int ** puzzle, int ** solution, int * numOfAttempts)
+*       int generatePatternPuzzle(int m, int n, int y, unsigned long seed, int ** puzzle, int ** solution)
+*       int getNumOfGenerateWorkers()
+*
+* NOTES :
+*       1. Attempts are numbered, and attempt number k uses random stream k of the seed (see Random.h),
+*          so an attempt makes the same choices whichever worker runs it.
+*       2. Every worker has its own board, solution and arrays, and takes the next attempt number until an attempt succeeds.
+*          The puzzle is the one of the successful attempt with the lowest number: once an attempt succeeds,
+*          no new attempt is started and the attempts with higher numbers are stopped (through the solver stop condition),
+*          while the lower attempts that are still running are finished.
+*          So the puzzle depends only on the seed - not on the number of workers or on their timing -
+*          and it is the same puzzle a serial run of the attempts would generate.
+*       3. With the backtracking solver, an attempt gives up (and fails) after about GENERATE_MAX_STEPS_PER_CELL
+*          search steps per board cell: proving that a randomly filled board has no solution may take
+*          far longer than new attempts. The steps are counted, not timed, so the puzzle still depends only on the seed.
+*       4. Boards with N >= PATTERN_GENERATE_MIN_N are too large for an ILP model (N^3 variables),
+*          so generatePuzzle builds their full grid directly (see generatePatternPuzzle), in O(N^2),
+*          and the X randomly filled cells aren't used.
+*       5. generatePuzzleWithin bounds the whole generation by a deadline (see Solver.h): no attempt is started
+*          once it passed, and the running attempts are stopped through their solver (the ILP solver gets the time
+*          that is left as its time limit). A generation that times out isn't reproducible, of course.
+*       6. Like the rest of libsudoku, the generator never prints and never exits.
+*       7. The files that include PuzzleGenerator.h must include Solver.h before it.
+*
+************************************/
+
+/* max number of generate worker threads */
+#define MAX_GENERATE_WORKERS 16
+
+/* boards with N of at least PATTERN_GENERATE_MIN_N are generated from the shifted pattern grid */
+#define PATTERN_GENERATE_MIN_N 36
+
+/* backtracking search steps per board cell an attempt may take before it gives up */
+#define GENERATE_MAX_STEPS_PER_CELL 64
+
+/*
+ * generates a puzzle on an empty N*N board (N = m*n, blocks of m rows and n columns), with at most maxAttempts attempts
+ * and numOfWorkers worker threads (see the notes above).
+ * boards with N >= PATTERN_GENERATE_MIN_N are generated by generatePatternPuzzle instead (x is ignored).
+ * the attempts solve the board with the solver backend (see Portfolio.h): BACKEND_ILP or BACKEND_BACKTRACKING.
+ * returns:
+ * 1. SUDOKU_OK - puzzle holds the Y cells that were kept (the other cells are 0), and solution holds the full solution
+ *    (puzzle and solution are N*N boards supplied by the caller).
+ * 2. SUDOKU_UNSOLVABLE - no attempt succeeded.
+ * 3. SUDOKU_SOLVER_ERROR - the ILP solver failed (never returned with BACKEND_BACKTRACKING).
+ * 4. SUDOKU_OUT_OF_MEMORY - a memory allocation failed.
+ */
+int generatePuzzle(int m, int n, int x, int y, unsigned long seed, int maxAttempts, int numOfWorkers, int backend,
+		int ** puzzle, int ** solution);
+
+/*
+ * same as generatePuzzle, but the generation is stopped once the deadline passed (deadline may be NULL - no deadline),
+ * and then SUDOKU_TIMEOUT is returned (unless an attempt succeeded or failed with an error before).
+ * the number of attempts is put in numOfAttempts (unless it is NULL): the number of the successful attempt
+ * (counting from 1), or the number of attempts that were started if no attempt succeeded
+ */
+int generatePuzzleWithin(int m, int n, int x, int y, unsigned long seed, int maxAttempts, int numOfWorkers, int backend,
+		SolverDeadline * deadline, int ** puzzle, int ** solution, int * numOfAttempts);
+
+/*
+ * generates a puzzle of N*N board (N = m*n, blocks of m rows and n columns) without a solver:
+ * 1. the full grid is the shifted pattern - row i of band b (the bands are n groups of m rows) is
+ *    the values 1..N shifted left by i*n + b.
+ * 2. the grid is randomized with transformations that keep it valid: the values are relabeled,
+ *    the bands and the rows within every band are permuted, and so are the stacks (m groups of n columns)
+ *    and the columns within every stack.
+ * 3. y random cells of the grid are kept in puzzle (the other cells are 0), and the full grid is put in solution.
+ * the puzzle depends only on the seed. returns SUDOKU_OK, or SUDOKU_OUT_OF_MEMORY
+ */
+int generatePatternPuzzle(int m, int n, int y, unsigned long seed, int ** puzzle, int ** solution);
+
+/*
+ * returns the number of generate workers: the number of online processors, at most MAX_GENERATE_WORKERS
+ */
+int getNumOfGenerateWorkers();
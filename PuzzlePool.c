@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "Solver.h"
+#include "Portfolio.h"
+#include "PuzzleGenerator.h"
+#include "Random.h"
+#include "PuzzlePool.h"
+#include "mainAux.h"
+
+/***** PuzzlePool inner functions *****/
+
+/*
+ * returns the seed of puzzle number index of the entry
+ */
+unsigned long getPooledPuzzleSeed(PoolEntry * entry, int index) {
+	return (entry->seed + (unsigned long) index * RANDOM_SEED_INCREMENT) & RANDOM_WORD_MASK;
+}
+
+/*
+ * frees the ready puzzles of the entry (the entry keeps its request)
+ */
+void clearPoolEntry(PuzzlePool * pool, PoolEntry * entry) {
+	int k;
+
+	for (k = 0; k < entry->numOfReady; k++) {
+		freeBoardSnapshot(entry->puzzles[(entry->firstReady + k) % pool->size]);
+		freeBoardSnapshot(entry->solutions[(entry->firstReady + k) % pool->size]);
+	}
+	entry->firstReady = 0;
+	entry->numOfReady = 0;
+}
+
+/*
+ * returns the entry of the request, replacing the least recently used entry if no entry matches it
+ * NOTE: the caller holds the pool lock
+ */
+PoolEntry * getPoolEntry(PuzzlePool * pool, int m, int n, int x, int y) {
+	PoolEntry * entry = NULL;
+	int k;
+
+	for (k = 0; k < PUZZLE_POOL_MAX_KEYS; k++) {
+		if (pool->entries[k].isUsed == 1 && pool->entries[k].m == m && pool->entries[k].n == n &&
+				pool->entries[k].x == x && pool->entries[k].y == y) {
+			return &pool->entries[k];
+		}
+		if (entry == NULL || (entry->isUsed == 1 &&
+				(pool->entries[k].isUsed == 0 || pool->entries[k].lastUsed < entry->lastUsed))) {
+			entry = &pool->entries[k];
+		}
+	}
+
+	clearPoolEntry(pool, entry);
+	entry->isUsed = 1;
+	entry->m = m;
+	entry->n = n;
+	entry->x = x;
+	entry->y = y;
+	entry->seed = nextRandom(&pool->random);
+	entry->epoch++;
+	entry->nextIndex = 0;
+	return entry;
+}
+
+/*
+ * returns the number of the entry the refill thread should fill next (the one with the fewest ready puzzles),
+ * or -1 if all the entries are full
+ * NOTE: the caller holds the pool lock
+ */
+int getEntryToRefill(PuzzlePool * pool) {
+	int best = -1;
+	int k;
+
+	for (k = 0; k < PUZZLE_POOL_MAX_KEYS; k++) {
+		if (pool->entries[k].isUsed == 1 && pool->entries[k].numOfReady < pool->size &&
+				(best == -1 || pool->entries[k].numOfReady < pool->entries[best].numOfReady)) {
+			best = k;
+		}
+	}
+	return best;
+}
+
+/*
+ * the refill thread: generates the next puzzle of the entry with the fewest ready puzzles,
+ * and sleeps while all the entries are full
+ */
+void * runPoolRefiller(void * arg) {
+	PuzzlePool * pool = (PuzzlePool *) arg;
+	PoolEntry * entry;
+	PoolEntry request;
+	int ** puzzle;
+	int ** solution;
+	int result;
+	int attempts;
+	int index;
+	int place;
+	int k;
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->stopping == 0) {
+		k = getEntryToRefill(pool);
+		if (k == -1) {
+			pthread_cond_wait(&pool->changed, &pool->lock);
+			continue;
+		}
+		entry = &pool->entries[k];
+		request = *entry;
+		index = entry->nextIndex + entry->numOfReady;
+		pool->generatingEntry = k;
+		pool->generatingEpoch = entry->epoch;
+		pool->generatingIndex = index;
+		pthread_mutex_unlock(&pool->lock);
+
+		puzzle = createBoardSnapshot(NULL, request.m * request.n);
+		solution = createBoardSnapshot(NULL, request.m * request.n);
+		result = SUDOKU_OUT_OF_MEMORY;
+		if (puzzle != NULL && solution != NULL) {
+			result = generatePuzzleWithin(request.m, request.n, request.x, request.y,
+					getPooledPuzzleSeed(&request, index), pool->maxAttempts, 1, BACKEND_ILP, NULL, puzzle, solution, &attempts);
+		}
+
+		pthread_mutex_lock(&pool->lock);
+		/* the puzzle is kept only if it is still the next one the entry needs (it could be taken or replaced meanwhile) */
+		if (result != SUDOKU_OUT_OF_MEMORY && entry->epoch == request.epoch &&
+				entry->nextIndex + entry->numOfReady == index && entry->numOfReady < pool->size) {
+			place = (entry->firstReady + entry->numOfReady) % pool->size;
+			entry->puzzles[place] = puzzle;
+			entry->solutions[place] = solution;
+			entry->results[place] = result;
+			entry->attempts[place] = attempts;
+			entry->numOfReady++;
+		}
+		else {
+			freeBoardSnapshot(puzzle);
+			freeBoardSnapshot(solution);
+		}
+		pool->generatingEntry = -1;
+		pthread_cond_broadcast(&pool->changed);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+
+/***** PuzzlePool.h implementation *****/
+
+PuzzlePool * createPuzzlePool(int size, unsigned long seed, int maxAttempts){
+	PuzzlePool * pool;
+	int k;
+
+	pool = (PuzzlePool *) malloc(sizeof(PuzzlePool));
+	if (pool == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	pool->size = size;
+	pool->maxAttempts = maxAttempts;
+	seedRandom(&pool->random, seed);
+	pool->numOfRequests = 0;
+	pool->generatingEntry = -1;
+	pool->stopping = 0;
+	for (k = 0; k < PUZZLE_POOL_MAX_KEYS; k++){
+		pool->entries[k].isUsed = 0;
+		pool->entries[k].epoch = 0;
+		pool->entries[k].firstReady = 0;
+		pool->entries[k].numOfReady = 0;
+		pool->entries[k].lastUsed = 0;
+		pool->entries[k].puzzles = (int ***) malloc(size*sizeof(int **));
+		pool->entries[k].solutions = (int ***) malloc(size*sizeof(int **));
+		pool->entries[k].results = (int *) malloc(size*sizeof(int));
+		pool->entries[k].attempts = (int *) malloc(size*sizeof(int));
+		if (pool->entries[k].puzzles == NULL || pool->entries[k].solutions == NULL || pool->entries[k].results == NULL ||
+				pool->entries[k].attempts == NULL){
+			printMemoryAllocationError();
+			exit(0);
+		}
+	}
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->changed, NULL);
+
+	if (pthread_create(&pool->refiller, NULL, runPoolRefiller, pool) != 0){
+		pool->stopping = 1;
+		freePuzzlePool(pool);
+		return NULL;
+	}
+	return pool;
+}
+
+void freePuzzlePool(PuzzlePool * pool){
+	int k;
+
+	if (pool == NULL){
+		return;
+	}
+	if (pool->stopping == 0){
+		pthread_mutex_lock(&pool->lock);
+		pool->stopping = 1;
+		pthread_cond_broadcast(&pool->changed);
+		pthread_mutex_unlock(&pool->lock);
+		pthread_join(pool->refiller, NULL);
+	}
+
+	for (k = 0; k < PUZZLE_POOL_MAX_KEYS; k++){
+		clearPoolEntry(pool, &pool->entries[k]);
+		free(pool->entries[k].puzzles);
+		free(pool->entries[k].solutions);
+		free(pool->entries[k].results);
+		free(pool->entries[k].attempts);
+	}
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->changed);
+	free(pool);
+}
+
+int takePooledPuzzle(PuzzlePool * pool, int m, int n, int x, int y, int numOfWorkers, SolverDeadline * deadline,
+		int ** puzzle, int ** solution, int * numOfAttempts, int * isGenerated){
+	PoolEntry * entry;
+	PoolEntry request;
+	int index;
+	int result;
+	int i;
+
+	pthread_mutex_lock(&pool->lock);
+	entry = getPoolEntry(pool, m, n, x, y);
+	entry->lastUsed = ++pool->numOfRequests;
+
+	/* the refill thread is generating this very puzzle - wait for it (a request with a deadline doesn't wait) */
+	while ((deadline == NULL || deadline->budgetMillis == 0) &&
+			entry->numOfReady == 0 && pool->generatingEntry == entry - pool->entries &&
+			pool->generatingEpoch == entry->epoch && pool->generatingIndex == entry->nextIndex){
+		pthread_cond_wait(&pool->changed, &pool->lock);
+	}
+
+	if (entry->numOfReady > 0){
+		for (i = 0; i < m*n; i++){
+			memcpy(puzzle[i], entry->puzzles[entry->firstReady][i], m*n*sizeof(int));
+			memcpy(solution[i], entry->solutions[entry->firstReady][i], m*n*sizeof(int));
+		}
+		result = entry->results[entry->firstReady];
+		if (numOfAttempts != NULL){
+			*numOfAttempts = entry->attempts[entry->firstReady];
+		}
+		if (isGenerated != NULL){
+			*isGenerated = 0;
+		}
+		freeBoardSnapshot(entry->puzzles[entry->firstReady]);
+		freeBoardSnapshot(entry->solutions[entry->firstReady]);
+		entry->firstReady = (entry->firstReady + 1) % pool->size;
+		entry->numOfReady--;
+		entry->nextIndex++;
+		pthread_cond_broadcast(&pool->changed);
+		pthread_mutex_unlock(&pool->lock);
+		return result;
+	}
+
+	/* no ready puzzle: it is generated here, while the refill thread starts on the next one */
+	index = entry->nextIndex++;
+	request = *entry;
+	pthread_cond_broadcast(&pool->changed);
+	pthread_mutex_unlock(&pool->lock);
+
+	if (isGenerated != NULL){
+		*isGenerated = 1;
+	}
+	return generatePuzzleWithin(m, n, x, y, getPooledPuzzleSeed(&request, index), pool->maxAttempts, numOfWorkers,
+			BACKEND_ILP, deadline, puzzle, solution, numOfAttempts);
+}
@@ -0,0 +1,113 @@
+/************************************
+* FILES NAMES :        PuzzlePool.c , PuzzlePool.h
+*
+* DESCRIPTION :
+*       Pre-generated puzzles pool of a game: a background thread keeps puzzles ready for the recent generate requests,
+*       so generate usually only copies a ready puzzle instead of generating it.
+*
+* PUBLIC FUNCTIONS :
+*       PuzzlePool * createPuzzlePool(int size, unsigned long seed, int maxAttempts)
+*       void freePuzzlePool(PuzzlePool * pool)
+*       int takePooledPuzzle(PuzzlePool * pool, int m, int n, int x, int y, int numOfWorkers, SolverDeadline * deadline,
+*                            int ** puzzle, int ** solution, int * numOfAttempts, int * isGenerated)
+*
+* NOTES :
+*       1. The pool has an entry for each of the last PUZZLE_POOL_MAX_KEYS generate requests (block dimensions m, n, X and Y),
+*          and the refill thread keeps up to size puzzles ready for every entry.
+*          A request that doesn't match an entry replaces the least recently used one.
+*       2. The puzzles of an entry are numbered, and puzzle number k is generated with its own seed
+*          (derived from the entry seed and k), whether the refill thread generated it or the request did.
+*          The entries seeds are taken, in order, from the pool seed - so a seeded game generates the same puzzles
+*          with or without ready puzzles in the pool.
+*       3. The refill thread runs a single generate worker, and sleeps while all the entries are full.
+*          A request for a puzzle the refill thread is generating waits for it instead of generating it again,
+*          unless the request has a deadline - then it generates the puzzle itself, within the deadline.
+*       4. The pool lock protects the entries. Freeing the pool waits for the puzzle the refill thread is generating.
+*       5. The files that include PuzzlePool.h must include pthread.h, Random.h and Solver.h before it.
+*
+************************************/
+
+/* number of generate requests (m, n, X, Y) the pool keeps puzzles for */
+#define PUZZLE_POOL_MAX_KEYS 4
+
+/*
+ * PoolEntry holds the ready puzzles of a single generate request:
+ * 1. isUsed - 1 iff the entry holds a request
+ * 2. m, n, x, y - the generate request
+ * 3. seed - the entry seed (see the notes above)
+ * 4. epoch - incremented when the entry is replaced, so a puzzle generated for the previous request is dropped
+ * 5. nextIndex - the number of the puzzle the next request takes
+ * 6. puzzles, solutions, results, attempts - a ring of size ready puzzles, with their solutions, generate sudokuResults
+ * 		and numbers of attempts:
+ * 		puzzle number nextIndex + i is in place (firstReady + i) % size, for i < numOfReady
+ * 7. lastUsed - the number of the last request of the entry (for replacing the least recently used entry)
+ */
+typedef struct PoolEntry{
+	int isUsed;
+	int m;
+	int n;
+	int x;
+	int y;
+	unsigned long seed;
+	long epoch;
+	int nextIndex;
+	int *** puzzles;
+	int *** solutions;
+	int * results;
+	int * attempts;
+	int firstReady;
+	int numOfReady;
+	long lastUsed;
+}PoolEntry;
+
+/*
+ * PuzzlePool struct contains:
+ * 1. lock - protects all the fields below
+ * 2. changed - broadcast when a puzzle was taken or made ready, an entry was replaced or the pool is stopping
+ * 3. refiller - the refill thread
+ * 4. size - number of ready puzzles the pool keeps for every entry
+ * 5. maxAttempts - max number of attempts of a single puzzle (see PuzzleGenerator.h)
+ * 6. random - the random generator the entries seeds are taken from
+ * 7. entries - the pool entries
+ * 8. numOfRequests - the number of requests so far
+ * 9. generatingEntry, generatingEpoch, generatingIndex - the puzzle the refill thread is generating
+ * 		(generatingEntry is -1 if none)
+ * 10. stopping - 1 iff the refill thread should exit
+ */
+typedef struct PuzzlePool{
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+	pthread_t refiller;
+	int size;
+	int maxAttempts;
+	RandomGenerator random;
+	PoolEntry entries[PUZZLE_POOL_MAX_KEYS];
+	long numOfRequests;
+	int generatingEntry;
+	long generatingEpoch;
+	int generatingIndex;
+	int stopping;
+}PuzzlePool;
+
+/*
+ * allocates a pool that keeps size ready puzzles for each of the recent generate requests,
+ * each generated with at most maxAttempts attempts, and starts its refill thread.
+ * returns NULL if the refill thread cannot be started
+ */
+PuzzlePool * createPuzzlePool(int size, unsigned long seed, int maxAttempts);
+
+/*
+ * stops the refill thread and frees the pool and its ready puzzles.
+ * if pool is NULL the function doesn't perform any operation
+ */
+void freePuzzlePool(PuzzlePool * pool);
+
+/*
+ * gets the next puzzle of the generate request: N*N board (N = m*n, blocks of m rows and n columns), X and Y.
+ * the puzzle and its solution are copied to puzzle and solution from the pool if it is ready there,
+ * otherwise it is generated with numOfWorkers workers until the deadline (see generatePuzzleWithin in PuzzleGenerator.h).
+ * returns the generate sudokuResult and puts the number of attempts in numOfAttempts, as generatePuzzleWithin does,
+ * and puts in isGenerated 1 iff the puzzle wasn't ready and was generated by this call (numOfAttempts and isGenerated may be NULL)
+ */
+int takePooledPuzzle(PuzzlePool * pool, int m, int n, int x, int y, int numOfWorkers, SolverDeadline * deadline,
+		int ** puzzle, int ** solution, int * numOfAttempts, int * isGenerated);
@@ -0,0 +1,103 @@
+#include <stdlib.h>
+#include <time.h>
+#include "Random.h"
+
+/***** Random inner functions *****/
+
+/*
+ * returns the 32 bit word x rotated left by k bits
+ */
+unsigned long rotateLeft(unsigned long x, int k) {
+	return ((x << k) | (x >> (32 - k))) & RANDOM_WORD_MASK;
+}
+
+/*
+ * returns a well mixed 32 bit word of x (the MurmurHash3 finalizer),
+ * so close seeds give unrelated states
+ */
+unsigned long mixWord(unsigned long x) {
+	x &= RANDOM_WORD_MASK;
+	x ^= x >> 16;
+	x = (x * 0x85EBCA6BUL) & RANDOM_WORD_MASK;
+	x ^= x >> 13;
+	x = (x * 0xC2B2AE35UL) & RANDOM_WORD_MASK;
+	x ^= x >> 16;
+	return x;
+}
+
+
+/***** Random.h implementation *****/
+
+void seedRandom(RandomGenerator * rng, unsigned long seed) {
+	int k;
+
+	for (k = 0; k < 4; k++) {
+		rng->state[k] = mixWord(seed + (k + 1) * RANDOM_SEED_INCREMENT);
+	}
+	/* the all zero state never leaves zero */
+	if ((rng->state[0] | rng->state[1] | rng->state[2] | rng->state[3]) == 0) {
+		rng->state[0] = 1;
+	}
+}
+
+void seedRandomFromClock(RandomGenerator * rng) {
+	unsigned long seed = (unsigned long) time(NULL);
+
+	seed = mixWord(seed) ^ (unsigned long) clock();
+	seed = mixWord(seed) ^ (unsigned long) rng;
+	seedRandom(rng, seed);
+}
+
+void seedRandomStream(RandomGenerator * rng, unsigned long seed, unsigned long stream) {
+	int k;
+
+	/* both keys are mixed on their own, so close seeds and close streams don't overlap */
+	for (k = 0; k < 4; k++) {
+		rng->state[k] = mixWord(mixWord(seed + (k + 1) * RANDOM_SEED_INCREMENT) ^
+				mixWord(stream + (k + 5) * RANDOM_SEED_INCREMENT));
+	}
+	if ((rng->state[0] | rng->state[1] | rng->state[2] | rng->state[3]) == 0) {
+		rng->state[0] = 1;
+	}
+}
+
+unsigned long nextRandom(RandomGenerator * rng) {
+	unsigned long * s = rng->state;
+	unsigned long result = (rotateLeft((s[1] * 5) & RANDOM_WORD_MASK, 7) * 9) & RANDOM_WORD_MASK;
+	unsigned long t = (s[1] << 9) & RANDOM_WORD_MASK;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotateLeft(s[3], 11);
+	return result;
+}
+
+int randomBelow(RandomGenerator * rng, int bound) {
+	unsigned long range = (unsigned long) bound;
+	/* 2^32 % range - the size of the incomplete last range */
+	unsigned long threshold = (RANDOM_WORD_MASK - range + 1) % range;
+	unsigned long r;
+
+	do {
+		r = nextRandom(rng);
+	} while (r < threshold);
+	return (int) (r % range);
+}
+
+void shuffleArray(RandomGenerator * rng, int * arr, int n) {
+	int i;
+	int j;
+	int temp;
+
+	/* start from the last element and swap one by one (no need to run for the first element) */
+	for (i = n-1; i > 0; i--) {
+		/* pick a random index from 0 to i, and swap arr[i] with it */
+		j = randomBelow(rng, i + 1);
+		temp = arr[i];
+		arr[i] = arr[j];
+		arr[j] = temp;
+	}
+}
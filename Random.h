@@ -0,0 +1,70 @@
+/************************************
+* FILES NAMES :        Random.c , Random.h
+*
+* DESCRIPTION :
+*       Per-game pseudo random number generator (xoshiro128**), used by generate to choose cells and values.
+*       Every game owns its generator, seeded once - from the --seed option, or from the clock -
+*       so a seeded game generates the same puzzles on every run, and consecutive shuffles always differ.
+*
+* PUBLIC FUNCTIONS :
+*       void seedRandom(RandomGenerator * rng, unsigned long seed)
+*       void seedRandomFromClock(RandomGenerator * rng)
+*       void seedRandomStream(RandomGenerator * rng, unsigned long seed, unsigned long stream)
+*       unsigned long nextRandom(RandomGenerator * rng)
+*       int randomBelow(RandomGenerator * rng, int bound)
+*       void shuffleArray(RandomGenerator * rng, int * arr, int n)
+*
+* NOTES :
+*       1. xoshiro128** works on 32 bit words. ANSI C has no 64 bit integer type, so the 32 bit member of the
+*          xoshiro family is used, with every word kept in an unsigned long masked to 32 bits.
+*       2. randomBelow is unbiased: values from the incomplete last range of 2^32 are rejected
+*          (instead of being folded by %, which favors the small values).
+*       3. The generator isn't thread safe, every thread must use its own generator.
+*          seedRandomStream gives the numbered independent streams of a seed, for work that is split between threads.
+*
+************************************/
+
+/* the generator words are 32 bit */
+#define RANDOM_WORD_MASK 0xFFFFFFFFUL
+
+/* the golden ratio constant, added between the words when the state is seeded */
+#define RANDOM_SEED_INCREMENT 0x9E3779B9UL
+
+/*
+ * RandomGenerator is the xoshiro128** state: 4 words of 32 bits (never all zero)
+ */
+typedef struct RandomGenerator{
+	unsigned long state[4];
+}RandomGenerator;
+
+/*
+ * seeds the generator: the same seed always gives the same sequence of random values
+ */
+void seedRandom(RandomGenerator * rng, unsigned long seed);
+
+/*
+ * seeds the generator from the current time, the processor time and the generator address
+ * (so games that start at the same second, in different threads, get different sequences)
+ */
+void seedRandomFromClock(RandomGenerator * rng);
+
+/*
+ * seeds the generator with stream number stream of seed:
+ * the streams of a seed are unrelated to each other, and the same seed and stream always give the same sequence
+ */
+void seedRandomStream(RandomGenerator * rng, unsigned long seed, unsigned long stream);
+
+/*
+ * returns the next 32 random bits of the generator
+ */
+unsigned long nextRandom(RandomGenerator * rng);
+
+/*
+ * returns a uniformly distributed random int in the range 0 to bound-1 (bound must be positive)
+ */
+int randomBelow(RandomGenerator * rng, int bound);
+
+/*
+ * generates a random permutation of the n ints of arr (Fisher-Yates shuffle)
+ */
+void shuffleArray(RandomGenerator * rng, int * arr, int n);
@@ -0,0 +1,244 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "WorkerPool.h"
+#include "GameFlow.h"
+#include "GenerateStats.h"
+#include "BoardFile.h"
+#include "Server.h"
+#include "mainAux.h"
+
+/*
+ * Session is a single server connection:
+ * 1. fd - the connection socket
+ * 2. options - the session game options
+ * 3. solverPool - the server solver pool
+ */
+typedef struct Session{
+	int fd;
+	GameOptions options;
+	WorkerPool * solverPool;
+}Session;
+
+/***** Server inner functions *****/
+
+/*
+ * fill addr with the Unix domain socket address of socketPath.
+ * returns 0 if the path is too long for a socket address
+ */
+int getSocketAddress(char * socketPath, struct sockaddr_un * addr){
+	if (strlen(socketPath) >= sizeof(addr->sun_path)){
+		return 0;
+	}
+	memset(addr, 0, sizeof(struct sockaddr_un));
+	addr->sun_family = AF_UNIX;
+	strcpy(addr->sun_path, socketPath);
+	return 1;
+}
+
+/*
+ * the session thread: runs a game that reads its commands from the connection and prints to it
+ */
+void * runSession(void * arg){
+	Session * session = (Session *) arg;
+	OutputContext context;
+	FILE * input;
+	FILE * output = NULL;
+	int outputFd;
+
+	/* the connection is read and written through two streams, each owns its own descriptor */
+	input = fdopen(session->fd, "r");
+	outputFd = dup(session->fd);
+	if (outputFd >= 0){
+		output = fdopen(outputFd, "w");
+	}
+	if (input == NULL || output == NULL){
+		if (input != NULL){
+			fclose(input);
+		}
+		else {
+			close(session->fd);
+		}
+		if (outputFd >= 0){
+			close(outputFd);
+		}
+		free(session);
+		return NULL;
+	}
+
+	initOutputContext(&context, output);
+	setOutputContext(&context);
+	runGame(input, &session->options, session->solverPool);
+	setOutputContext(NULL);
+
+	fclose(output);
+	fclose(input);
+	free(session);
+	return NULL;
+}
+
+/*
+ * start a detached session thread for the accepted connection fd.
+ * the connection is closed if the thread cannot be started
+ */
+void startSession(int fd, GameOptions * options, WorkerPool * solverPool){
+	Session * session;
+	pthread_t thread;
+	pthread_attr_t attr;
+
+	session = (Session *) malloc(sizeof(Session));
+	if (session == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	session->fd = fd;
+	session->options = *options;
+	session->solverPool = solverPool;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if (pthread_create(&thread, &attr, runSession, session) != 0){
+		close(fd);
+		free(session);
+	}
+	pthread_attr_destroy(&attr);
+}
+
+
+/***** Server.h implementation *****/
+
+int runServer(char * socketPath, int numOfWorkers, GameOptions * options){
+	struct sockaddr_un addr;
+	struct sigaction ignore;
+	struct stat pathStat;
+	GameOptions sessionOptions;
+	WorkerPool * solverPool;
+	int listenFd;
+	int fd;
+
+	/* a client that disconnects in the middle of a reply must not kill the server */
+	memset(&ignore, 0, sizeof(ignore));
+	ignore.sa_handler = SIG_IGN;
+	sigemptyset(&ignore.sa_mask);
+	sigaction(SIGPIPE, &ignore, NULL);
+
+	if (getSocketAddress(socketPath, &addr) == 0){
+		printServerSocketError(socketPath);
+		return EXIT_STATUS_USAGE_ERROR;
+	}
+	listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0){
+		printServerSocketError(socketPath);
+		return EXIT_STATUS_USAGE_ERROR;
+	}
+	/* only a stale socket is replaced - any other file in the path is left alone */
+	if (lstat(socketPath, &pathStat) == 0){
+		if (!S_ISSOCK(pathStat.st_mode) || unlink(socketPath) != 0){
+			printServerSocketError(socketPath);
+			close(listenFd);
+			return EXIT_STATUS_USAGE_ERROR;
+		}
+	}
+	if (bind(listenFd, (struct sockaddr *) &addr, sizeof(addr)) != 0 ||
+			listen(listenFd, SERVER_LISTEN_BACKLOG) != 0){
+		printServerSocketError(socketPath);
+		close(listenFd);
+		return EXIT_STATUS_USAGE_ERROR;
+	}
+
+	solverPool = createWorkerPool(numOfWorkers);
+	if (solverPool == NULL){
+		printServerSocketError(socketPath);
+		close(listenFd);
+		unlink(socketPath);
+		return EXIT_STATUS_USAGE_ERROR;
+	}
+	/* the sessions share one generate auto statistics table, so each save has the runs of all of them */
+	sessionOptions = *options;
+	if (options->generateStatsPath != NULL){
+		sessionOptions.generateStats = loadGenerateStats(options->generateStatsPath);
+	}
+	printServerStarted(socketPath, numOfWorkers);
+	fflush(getOutput());
+
+	while (1){
+		fd = accept(listenFd, NULL, NULL);
+		if (fd < 0){
+			continue;
+		}
+		startSession(fd, &sessionOptions, solverPool);
+	}
+}
+
+int runClient(char * socketPath){
+	struct sockaddr_un addr;
+	struct pollfd fds[2];
+	unsigned char buf[CLIENT_BUFFER_SIZE];
+	ssize_t len;
+	int fd;
+
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0 || getSocketAddress(socketPath, &addr) == 0 ||
+			connect(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0){
+		printServerConnectError(socketPath);
+		if (fd >= 0){
+			close(fd);
+		}
+		return EXIT_STATUS_USAGE_ERROR;
+	}
+
+	/* fds[0] is the standard input (a negative fd is ignored by poll once it ended) */
+	fds[0].fd = STDIN_FILENO;
+	fds[0].events = POLLIN;
+	fds[1].fd = fd;
+	fds[1].events = POLLIN;
+
+	while (1){
+		if (poll(fds, 2, -1) < 0){
+			if (errno == EINTR){
+				continue;
+			}
+			break;
+		}
+
+		/* the server output */
+		if (fds[1].revents != 0){
+			len = read(fd, buf, CLIENT_BUFFER_SIZE);
+			if (len < 0 && errno == EINTR){
+				continue;
+			}
+			if (len <= 0 || writeAll(STDOUT_FILENO, buf, len) == 0){
+				break;
+			}
+		}
+
+		/* the user commands, the end of the input is passed on to the server */
+		if (fds[0].fd >= 0 && fds[0].revents != 0){
+			len = read(STDIN_FILENO, buf, CLIENT_BUFFER_SIZE);
+			if (len < 0 && errno == EINTR){
+				continue;
+			}
+			if (len <= 0){
+				shutdown(fd, SHUT_WR);
+				fds[0].fd = -1;
+			}
+			else if (writeAll(fd, buf, len) == 0){
+				break;
+			}
+		}
+	}
+
+	close(fd);
+	return EXIT_STATUS_SUCCESS;
+}
@@ -0,0 +1,48 @@
+/************************************
+* FILES NAMES :        Server.c , Server.h
+*
+* DESCRIPTION :
+*       Multi-session sudoku server over a Unix domain socket, and a minimal client for it.
+*       Every accepted connection is an independent game session (its own Game and game loop) in its own thread,
+*       and all the sessions send their solver commands to one shared solver pool (see WorkerPool.h).
+*
+* PUBLIC FUNCTIONS :
+*       int runServer(char * socketPath, int numOfWorkers, GameOptions * options)
+*       int runClient(char * socketPath)
+*
+* NOTES :
+*       1. A session reads its commands from the connection and prints everything (messages, boards
+*          and protocol replies) back to it, exactly as the program does on the standard input and output.
+*          The session ends, and the connection is closed, on an exit command or when the client closes its side.
+*       2. The client relays the standard input to the server and the server output to the standard output,
+*          so interactive use, commands files (redirected input) and protocol mode work the same through it.
+*       3. A fatal error (memory allocation failure) still terminates the whole server process.
+*       4. With a generate statistics file (-g), the sessions share one statistics table (see GenerateStats.h),
+*          so a session save never drops the generates of the others.
+*       5. The files that include Server.h must include GameFlow.h before it.
+*
+************************************/
+
+/* default number of solver pool workers */
+#define DEFAULT_NUM_OF_SOLVER_WORKERS 4
+
+/* max number of pending connections */
+#define SERVER_LISTEN_BACKLOG 16
+
+/* size of the client relay buffer */
+#define CLIENT_BUFFER_SIZE 4096
+
+/*
+ * listens on a Unix domain socket in socketPath (a stale socket file is replaced, any other file in the path fails it)
+ * and runs a game session for every connection, with a solver pool of numOfWorkers workers.
+ * options are the game options of every session (see GameFlow.h).
+ * returns EXIT_STATUS_USAGE_ERROR if the server cannot be started, otherwise it never returns
+ */
+int runServer(char * socketPath, int numOfWorkers, GameOptions * options);
+
+/*
+ * connects to the server listening in socketPath and relays the standard input to it
+ * and its output to the standard output, until the server closes the connection.
+ * returns EXIT_STATUS_SUCCESS, or EXIT_STATUS_USAGE_ERROR if it cannot connect to the server
+ */
+int runClient(char * socketPath);
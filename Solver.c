@@ -1,55 +1,38 @@
+#define _POSIX_C_SOURCE 200112L
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include "gurobi_c.h"
-#include "Game.h"
-#include "mainAux.h"
+#include "Solver.h"
 
 /*
  * allocate memory for Gurobi model and environment
- * if there is a problem with one of the memory allocations
- * the program prints error to the user and exit
+ * returns 0 if there is a problem with one of the memory allocations
+ * (the arrays that were allocated are freed by freeGurobi)
  */
-void allocateGurobi (int N, double ** lb, char ** vtype, char *** names,
+int allocateGurobi (int N, double ** lb, char ** vtype, char *** names,
 		char ** namestorage,  int ** ind, double ** val){
 
 	int N3 = N*N*N;
+	/* a variable name is "x[i,j,k]" and a null char, with up to as many digits as N in each index */
+	int nameSize = 6;
+	int x;
 
-	*lb = (double *) malloc(N3*sizeof(double));
-	if (*lb == NULL){
-		printMemoryAllocationError();
-		exit(0);
+	for (x = N; x > 0; x /= 10) {
+		nameSize += 3;
 	}
 
+	*lb = (double *) malloc(N3*sizeof(double));
 	*vtype = (char *) malloc(N3*sizeof(char));
-	if (*vtype == NULL){
-		printMemoryAllocationError();
-		exit(0);
-	}
-
 	*names = (char**) malloc(N3 * sizeof(char*));
-	if (*names == NULL){
-		printMemoryAllocationError();
-		exit(0);
-	}
-
-	*namestorage = (char*) malloc(10*N3);
-	if (*namestorage == NULL){
-		printMemoryAllocationError();
-		exit(0);
-	}
-
+	*namestorage = (char*) malloc((long) nameSize*N3);
 	*ind = (int*) malloc (N*sizeof(int));
-	if (*ind == NULL){
-		printMemoryAllocationError();
-		exit(0);
-	}
-
 	*val = (double*) malloc (N*sizeof(double));
-	if (*val == NULL){
-		printMemoryAllocationError();
-		exit(0);
-	}
+
+	return *lb != NULL && *vtype != NULL && *names != NULL &&
+			*namestorage != NULL && *ind != NULL && *val != NULL;
 }
 
 /*
@@ -73,21 +56,19 @@ void freeGurobi(GRBenv * env , GRBmodel * model , double * lb, char * vtype,
 }
 
 /*
- * fill game->solvedBoard with the optimal solution values for each cell
+ * fill solution with the optimal solution values for each cell
  */
-void fillSolvedBoard(Game* game, double* vals) {
+void fillSolvedBoard(int ** solution, int N, double* vals) {
 	int i;
 	int j;
 	int k;
 
-	int N = game->N;
-
 	for (i = 0; i < N; i++) {
 		for (j = 0; j < N; j++) {
 			for (k = 0; k < N; k++) {
 				/* solvedBoard[i][j] = k+1 iff vals[i*N*N + j*N + k] == 1.0 */
 				if(vals[i*N*N + j*N + k] != 0.0) {
-					game->solvedBoard[i][j] = k+1;
+					solution[i][j] = k+1;
 				}
 			}
 		}
@@ -96,23 +77,22 @@ void fillSolvedBoard(Game* game, double* vals) {
 
 /*
  * Fill the arrays namestorage, lb, vtype, names
- * according to the game board.
+ * according to the board.
  * These arrays are used by Gurobi to know which cells are already filled.
  */
-void createEmptyGurobiModel(Game * game, char ** namestorage, double ** lb,
+void createEmptyGurobiModel(int ** board, int N, char ** namestorage, double ** lb,
 		char ** vtype, char *** names) {
 	int i;
 	int j;
 	int k;
 	char * cursor = NULL;
-	int N = game->N;
 
 	cursor = *namestorage;
 	for (i = 0; i < N; i++) {
 		for (j = 0; j < N; j++) {
 			for (k = 0; k < N; k++) {
 				/* lb indicates the non Empty cells values in the supplied board */
-				if (game->gameBoard[i][j]-1 == k) {
+				if (board[i][j]-1 == k) {
 					(*lb)[i*N*N+j*N+k] = 1;
 				}
 				else {
@@ -279,6 +259,42 @@ int addConstraints(int N, int m, int n, GRBmodel * model, int ** ind, double **
 	return 0;
 }
 
+/*
+ * ILPStop is the data of the Gurobi callback of solveBoardWithILPWithin:
+ * the caller stop condition and its argument (shouldStop may be NULL), and the deadline (may be NULL)
+ */
+typedef struct ILPStop{
+	int (*shouldStop)(void * arg);
+	void * stopArg;
+	SolverDeadline * deadline;
+}ILPStop;
+
+/*
+ * the Gurobi callback of solveBoardWithILPWithin (called periodically while the model is optimized):
+ * terminates the optimization once the caller stop condition returns 1 or the deadline passed
+ */
+int stopILPCallback(GRBmodel * model, void * cbdata, int where, void * usrdata) {
+	ILPStop * stop = (ILPStop *) usrdata;
+
+	(void) cbdata;
+	(void) where;
+	if ((stop->shouldStop != NULL && stop->shouldStop(stop->stopArg) == 1) ||
+			isSolverDeadlinePassed(stop->deadline) == 1) {
+		GRBterminate(model);
+	}
+	return 0;
+}
+
+/*
+ * returns the milliseconds that passed since the deadline budget started
+ */
+long getSolverElapsedMillis(SolverDeadline * deadline) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((long) now.tv_sec - deadline->startSec) * 1000L + (now.tv_nsec - deadline->startNsec) / 1000000L;
+}
+
 /*
  * optimize model and save optimal status to optimstatus.
  * returns 1 iff an error occured
@@ -302,34 +318,170 @@ int optimizeModel(GRBmodel * model, int * optimstatus) {
 }
 
 
+
 /*
- * finds the indexes of the first empty cell
- * going up to down and left to right
- * and puts them in row and col
-*/
-void getFirstEmptyCell(Game * game, int * row, int *col) {
-	int i;
-	int j;
-	int N = game->N;
-
-	for(i = 0; i < N; i++) {
-		for(j = 0; j < N; j++) {
-			if(game->gameBoard[i][j] == 0) {
-				*row = i;
-				*col = j;
-				return;
+ * returns 1 iff value doesn't appear in the row, the column or the block of cell number cell
+ * (row by row) of the N*N board cells, not counting the cell itself
+ */
+int isLegalValue(int * cells, int m, int n, int cell, int value) {
+	int k;
+	int N = m*n;
+	int row = cell / N;
+	int col = cell % N;
+	int blockRow = row - row % m;
+	int blockCol = col - col % n;
+
+	for (k = 0; k < N; k++) {
+		if ((k != col && cells[row*N + k] == value) ||
+				(k != row && cells[k*N + col] == value)) {
+			return 0;
+		}
+		if ((blockRow + k / n)*N + blockCol + k % n != cell &&
+				cells[(blockRow + k / n)*N + blockCol + k % n] == value) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * returns the index of the block of cell <row,col> (blocks of m rows and n columns, row by row)
+ */
+int getBlockIndex(int m, int n, int row, int col) {
+	return (row / m) * m + col / n;
+}
+
+/*
+ * sets the mark of value in the row, the column and the block of cell number cell (row by row):
+ * used holds a mark for every value (1 to N) of every row, column and block of the N*N board
+ */
+void markUsedValue(char * used, int m, int n, int cell, int value, char mark) {
+	int N = m*n;
+	int row = cell / N;
+	int col = cell % N;
+
+	used[row*(N+1) + value] = mark;
+	used[(N + col)*(N+1) + value] = mark;
+	used[(2*N + getBlockIndex(m, n, row, col))*(N+1) + value] = mark;
+}
+
+/*
+ * returns 1 iff value isn't marked in the row, the column or the block of cell number cell (see markUsedValue)
+ */
+int isUnusedValue(char * used, int m, int n, int cell, int value) {
+	int N = m*n;
+	int row = cell / N;
+	int col = cell % N;
+
+	return used[row*(N+1) + value] == 0 &&
+			used[(N + col)*(N+1) + value] == 0 &&
+			used[(2*N + getBlockIndex(m, n, row, col))*(N+1) + value] == 0;
+}
+
+/*
+ * a single propagation pass over the board cells (see propagateBoard):
+ * fills the naked singles and then the hidden singles of every unit, and puts in progress
+ * the number of cells it filled. returns SUDOKU_UNSOLVABLE if it found a contradiction, otherwise SUDOKU_OK
+ */
+int propagateSingles(int * cells, char * used, int m, int n, int * progress) {
+	int N = m*n;
+	int cell;
+	int unit;
+	int k;
+	int v;
+	int cnt;
+	int last = 0;
+
+	*progress = 0;
+	for (cell = 0; cell < N*N; cell++) {
+		if (cells[cell] != 0) {
+			continue;
+		}
+		cnt = 0;
+		for (v = 1; v <= N && cnt < 2; v++) {
+			if (isUnusedValue(used, m, n, cell, v) == 1) {
+				cnt++;
+				last = v;
+			}
+		}
+		if (cnt == 0) {
+			return SUDOKU_UNSOLVABLE;
+		}
+		if (cnt == 1) {
+			cells[cell] = last;
+			markUsedValue(used, m, n, cell, last, 1);
+			(*progress)++;
+		}
+	}
+
+	for (unit = 0; unit < 3*N; unit++) {
+		for (v = 1; v <= N; v++) {
+			if (used[unit*(N+1) + v] != 0) {
+				continue;
+			}
+			cnt = 0;
+			for (k = 0; k < N && cnt < 2; k++) {
+				cell = getUnitCell(m, n, unit, k);
+				if (cells[cell] == 0 && isUnusedValue(used, m, n, cell, v) == 1) {
+					cnt++;
+					last = cell;
+				}
 			}
+			if (cnt == 0) {
+				return SUDOKU_UNSOLVABLE;
+			}
+			if (cnt == 1) {
+				cells[last] = v;
+				markUsedValue(used, m, n, last, v, 1);
+				(*progress)++;
+			}
+		}
+	}
+	return SUDOKU_OK;
+}
+
+/*
+ * returns the empty cell with the fewest legal values, and puts their number in numOfOptions.
+ * returns -1 if the board has no empty cells
+ */
+int getMostConstrainedCell(int * cells, char * used, int m, int n, int * numOfOptions) {
+	int cell;
+	int v;
+	int cnt;
+	int best = -1;
+	int N = m*n;
+
+	*numOfOptions = N + 1;
+	for (cell = 0; cell < N*N && *numOfOptions > 1; cell++) {
+		if (cells[cell] != 0) {
+			continue;
+		}
+		cnt = 0;
+		for (v = 1; v <= N; v++) {
+			cnt += isUnusedValue(used, m, n, cell, v);
+		}
+		if (cnt < *numOfOptions) {
+			best = cell;
+			*numOfOptions = cnt;
 		}
 	}
-	*row = N;
-	*col = N;
+	return best;
 }
 
 
 
 /* Solver.h implementation */
 
-int solveBoardWithILP(Game* game){
+int solveBoardWithILP(int ** board, int m, int n, int ** solution){
+	return solveBoardWithILPUntil(board, m, n, NULL, NULL, solution);
+}
+
+int solveBoardWithILPUntil(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg, int ** solution){
+	return solveBoardWithILPWithin(board, m, n, shouldStop, stopArg, NULL, solution);
+}
+
+int solveBoardWithILPWithin(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg,
+		SolverDeadline * deadline, int ** solution){
 	int optimstatus;
 	double objval;
 	double * lb = NULL;
@@ -341,134 +493,415 @@ int solveBoardWithILP(Game* game){
 	GRBenv *env = NULL;
 	GRBmodel *model = NULL;
 	int error = 0;
+	int N = m*n;
+	double timeLeft;
+	ILPStop stop;
+
+	/* propagation alone decides many boards (most of the failed generate attempts), without a Gurobi model */
+	error = propagateBoard(board, m, n, solution);
+	if (error != SUDOKU_UNDECIDED) {
+		return error;
+	}
+	error = 0;
 
 	/* allocate all memory needed for gurobi */
-	allocateGurobi (game->N, &lb, &vtype, &names, &namestorage,  &ind, &val);
+	if (allocateGurobi (N, &lb, &vtype, &names, &namestorage,  &ind, &val) == 0) {
+		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
+		return SUDOKU_OUT_OF_MEMORY;
+	}
 
 	/* Create an empty model */
-	createEmptyGurobiModel(game, &namestorage, &lb, &vtype, &names);
+	createEmptyGurobiModel(board, N, &namestorage, &lb, &vtype, &names);
 
 	/* Create environment */
 	error = GRBloadenv(&env, "sudoku.log");
 	if (error) {
 		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
-		return 0;
+		return SUDOKU_SOLVER_ERROR;
 	}
 
 	/* Create new model */
-	error = GRBnewmodel(env, &model, "sudoku", game->N*game->N*game->N,
+	error = GRBnewmodel(env, &model, "sudoku", N*N*N,
 						NULL, lb, NULL, vtype, names);
 	if (error) {
 		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
-		return 0;
+		return SUDOKU_SOLVER_ERROR;
 	}
 
 	/* add all constraints */
-	error = addConstraints(game->N, game->m, game->n, model, &ind, &val);
+	error = addConstraints(N, m, n, model, &ind, &val);
 	if (error) {
 		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
-		return 0;
+		return SUDOKU_SOLVER_ERROR;
+	}
+
+	/* the optimization gets the time that is left of the deadline */
+	if (deadline != NULL && deadline->budgetMillis > 0) {
+		timeLeft = (deadline->budgetMillis - getSolverElapsedMillis(deadline)) / 1000.0;
+		error = GRBsetdblparam(GRBgetenv(model), GRB_DBL_PAR_TIMELIMIT, timeLeft > 0 ? timeLeft : 0);
+		if (error) {
+			freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
+			return SUDOKU_SOLVER_ERROR;
+		}
+	}
+
+	/* let the caller stop the optimization (the callback also checks the deadline, between the time limit checks) */
+	if (shouldStop != NULL || deadline != NULL) {
+		stop.shouldStop = shouldStop;
+		stop.stopArg = stopArg;
+		stop.deadline = deadline;
+		error = GRBsetcallbackfunc(model, stopILPCallback, &stop);
+		if (error) {
+			freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
+			return SUDOKU_SOLVER_ERROR;
+		}
 	}
 
 	/* optimize model and capture solution information */
 	error = optimizeModel(model, &optimstatus);
 	if (error) {
 		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
-		return 0;
+		return SUDOKU_SOLVER_ERROR;
 	}
 
 	/*
 	 * check if boards is Solvable according to optimization status
-	 * if it is - extract optimal solution to solvedBoard
+	 * if it is - extract optimal solution to solution
 	 */
-	if (optimstatus == GRB_OPTIMAL) {
-	    game->isSolvable = 1;
+	if (optimstatus == GRB_INFEASIBLE) {
+		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
+		return SUDOKU_UNSOLVABLE;
+	}
+	if (optimstatus == GRB_TIME_LIMIT ||
+			(optimstatus == GRB_INTERRUPTED && isSolverDeadlinePassed(deadline) == 1)) {
+		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
+		return SUDOKU_TIMEOUT;
+	}
+	if (optimstatus == GRB_INTERRUPTED) {
+		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
+		return SUDOKU_STOPPED;
+	}
+	if (optimstatus != GRB_OPTIMAL) {
+		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
+		return SUDOKU_SOLVER_ERROR;
+	}
+	if (solution != NULL) {
 		error = GRBgetdblattr(model, GRB_DBL_ATTR_OBJVAL, &objval);
 		if (error){
 			freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
-			return 0;
+			return SUDOKU_SOLVER_ERROR;
 		}
 		/* get the solution - the assignment to each variable */
-		error = GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0, game->N*game->N*game->N, lb);
+		error = GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0, N*N*N, lb);
 		if (error){
 			freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
-			return 0;
+			return SUDOKU_SOLVER_ERROR;
 		}
-		/* fill solved board with the solution values */
-		fillSolvedBoard(game, lb);
-	}
-	else if (optimstatus == GRB_INFEASIBLE) {
-		game->isSolvable = 0;
-	}
-	else {
-		freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
-		return 0;
+		/* fill solution with the solution values */
+		fillSolvedBoard(solution, N, lb);
 	}
 	/* free memory allocation in the end of the function */
 	freeGurobi(env , model , lb, vtype, names, namestorage, ind, val);
-	return 1;
+	return SUDOKU_OK;
+}
+
+int cntNumSolutions(int ** board, int m, int n, int * numOfSolutions){
+	return cntNumSolutionsUntil(board, m, n, NULL, NULL, numOfSolutions);
 }
 
-int cntNumSolutions(Game * game){
+int cntNumSolutionsUntil(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg, int * numOfSolutions){
+	int i;
+	int j;
 	int v;
-	int val;
-    int i = 0;
-	int j = 0;
+	int cell;
+	int depth = 0;
+	int numOfEmptyCells = 0;
 	int cntSoultions = 0;
-	int N = game->N;
-
-	/* Initialize stack */
-	LinkedList * stack = createStack();
-
-	/* get first empty cell */
-	getFirstEmptyCell(game, &i, &j);
-
-	/* insert the first empty cell to stack with value 1 */
-	pushStack(stack, i, j, 1);
+	long steps = 0;
+	int N = m*n;
+	/* the search works on its own copy of the board */
+	int * cells = (int *) malloc((long) N*N*sizeof(int));
+	/* the stack - the empty cells in order, depth is the number of cells with a value on the stack */
+	int * emptyCells = (int *) malloc((long) N*N*sizeof(int));
+
+	if (cells == NULL || emptyCells == NULL) {
+		free(cells);
+		free(emptyCells);
+		return SUDOKU_OUT_OF_MEMORY;
+	}
+	for (i = 0; i < N; i++) {
+		for (j = 0; j < N; j++) {
+			cells[i*N + j] = board[i][j];
+			if (board[i][j] == 0) {
+				emptyCells[numOfEmptyCells++] = i*N + j;
+			}
+		}
+	}
 
-	/* run backtracking until stack is empty */
-	while(isEmptyStack(stack) == 0) {
+	/* run backtracking until the first empty cell has no more options */
+	while(depth >= 0) {
 
-		/* get top item and pop it */
-		topStack(stack, &i, &j, &val);
-		popStack(stack);
+		/* let the caller stop a long search */
+		if (shouldStop != NULL && ++steps % SOLVER_STOP_CHECK_INTERVAL == 0 && shouldStop(stopArg) == 1) {
+			free(cells);
+			free(emptyCells);
+			return SUDOKU_STOPPED;
+		}
 
 		/* check if the board is filled */
-		if(i == N) {
+		if(depth == numOfEmptyCells) {
 
 			/* increment soulutions counter */
 			cntSoultions++;
+			depth--;
 			continue;
 		}
 
-		/* continue checking options for the current cell */
-		for(v = val; v <= N; v++) {
+		/* continue checking options for the current cell, after its current value */
+		cell = emptyCells[depth];
+		for(v = cells[cell] + 1; v <= N; v++) {
+			if (isLegalValue(cells, m, n, cell, v) == 1) {
+				break;
+			}
+		}
+
+		/* go on to the next empty cell, or set the cell back to 0 and backtrack */
+		if(v <= N) {
+			cells[cell] = v;
+			depth++;
+		}
+		else {
+			cells[cell] = 0;
+			depth--;
+		}
+	}
+
+	free(cells);
+	free(emptyCells);
+	*numOfSolutions = cntSoultions;
+	return SUDOKU_OK;
+}
+
+int solveBoardWithBacktracking(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg, int ** solution){
+	int i;
+	int j;
+	int v;
+	int cell;
+	int numOfOptions;
+	int depth = 0;
+	int descend = 1;
+	int result = SUDOKU_UNSOLVABLE;
+	long steps = 0;
+	int N = m*n;
+	/* the search works on its own copy of the board */
+	int * cells = (int *) malloc((long) N*N*sizeof(int));
+	/* the stack - the cells the search filled, in order, depth is the number of cells on the stack */
+	int * filledCells = (int *) malloc((long) N*N*sizeof(int));
+	/* the values used in every row, column and block (see markUsedValue) */
+	char * used = (char *) calloc(3*N*(N+1), sizeof(char));
+
+	if (cells == NULL || filledCells == NULL || used == NULL) {
+		free(cells);
+		free(filledCells);
+		free(used);
+		return SUDOKU_OUT_OF_MEMORY;
+	}
+	for (i = 0; i < N; i++) {
+		for (j = 0; j < N; j++) {
+			cells[i*N + j] = board[i][j];
+			if (board[i][j] == 0) {
+				continue;
+			}
+			/* a value outside 1..N (it has no mark in used), or two equal values in a row, column or block */
+			if (board[i][j] < 0 || board[i][j] > N) {
+				depth = -1;
+				continue;
+			}
+			if (isUnusedValue(used, m, n, i*N + j, board[i][j]) == 0) {
+				depth = -1;
+			}
+			markUsedValue(used, m, n, i*N + j, board[i][j], 1);
+		}
+	}
 
-			/* check if v is a legal option */
-			game->gameBoard[i][j] = v;
-			if (checkAndMarkBoardErrorsInCol(game, i, j, 0) == 0 &&
-					checkAndMarkBoardErrorsInRow(game, i, j, 0) == 0 &&
-					checkAndMarkBoardErrorsInBlock(game, i, j, 0) == 0) {
+	while (depth >= 0) {
 
-				/* insert cell with next option to stack */
-				pushStack(stack, i, j, v+1);
+		/* let the caller stop a long search */
+		if (shouldStop != NULL && ++steps % SOLVER_STOP_CHECK_INTERVAL == 0 && shouldStop(stopArg) == 1) {
+			result = SUDOKU_STOPPED;
+			break;
+		}
 
-				/* get next empty cell */
-				getFirstEmptyCell(game, &i, &j);
+		/* a new cell is filled next - pick the empty cell with the fewest options */
+		if (descend == 1) {
+			cell = getMostConstrainedCell(cells, used, m, n, &numOfOptions);
+			if (cell == -1) {
+				result = SUDOKU_OK;
+				break;
+			}
+			if (numOfOptions == 0) {
+				descend = 0;
+				depth--;
+				continue;
+			}
+			filledCells[depth] = cell;
+		}
 
-				/* insert next cell with 1 to stack */
-				pushStack(stack, i, j, 1);
+		/* try the next legal value of the cell, after its current value */
+		cell = filledCells[depth];
+		if (cells[cell] != 0) {
+			markUsedValue(used, m, n, cell, cells[cell], 0);
+		}
+		for (v = cells[cell] + 1; v <= N; v++) {
+			if (isUnusedValue(used, m, n, cell, v) == 1) {
 				break;
 			}
 		}
 
-		/* set cell back to 0 */
-		if(v == N+1) {
-			game->gameBoard[i][j] = 0;
+		/* go on to the next cell, or set the cell back to 0 and backtrack */
+		if (v <= N) {
+			cells[cell] = v;
+			markUsedValue(used, m, n, cell, v, 1);
+			depth++;
+			descend = 1;
+		}
+		else {
+			cells[cell] = 0;
+			depth--;
+			descend = 0;
+		}
+	}
+
+	if (result == SUDOKU_OK && solution != NULL) {
+		for (i = 0; i < N; i++) {
+			memcpy(solution[i], cells + (long) i*N, N*sizeof(int));
+		}
+	}
+	free(cells);
+	free(filledCells);
+	free(used);
+	return result;
+}
+
+int propagateBoard(int ** board, int m, int n, int ** solution){
+	int i;
+	int j;
+	int progress;
+	int numOfEmptyCells = 0;
+	int result = SUDOKU_OK;
+	int N = m*n;
+	/* propagation works on its own copy of the board */
+	int * cells = (int *) malloc((long) N*N*sizeof(int));
+	/* the values used in every row, column and block (see markUsedValue) */
+	char * used = (char *) calloc(3*N*(N+1), sizeof(char));
+
+	if (cells == NULL || used == NULL) {
+		free(cells);
+		free(used);
+		return SUDOKU_OUT_OF_MEMORY;
+	}
+	for (i = 0; i < N; i++) {
+		for (j = 0; j < N; j++) {
+			cells[i*N + j] = board[i][j];
+			if (board[i][j] == 0) {
+				numOfEmptyCells++;
+				continue;
+			}
+			/* a value outside 1..N (it has no mark in used), or two equal values in a row, column or block */
+			if (board[i][j] < 0 || board[i][j] > N) {
+				result = SUDOKU_UNSOLVABLE;
+				continue;
+			}
+			if (isUnusedValue(used, m, n, i*N + j, board[i][j]) == 0) {
+				result = SUDOKU_UNSOLVABLE;
+			}
+			markUsedValue(used, m, n, i*N + j, board[i][j], 1);
+		}
+	}
+
+	/* a pass that fills no cell leaves the board as it is, so propagation stops there */
+	while (result == SUDOKU_OK && numOfEmptyCells > 0) {
+		result = propagateSingles(cells, used, m, n, &progress);
+		numOfEmptyCells -= progress;
+		if (progress == 0) {
+			result = SUDOKU_UNDECIDED;
+		}
+	}
+
+	if (result == SUDOKU_OK && solution != NULL) {
+		for (i = 0; i < N; i++) {
+			memcpy(solution[i], cells + (long) i*N, N*sizeof(int));
+		}
+	}
+	free(cells);
+	free(used);
+	return result;
+}
+
+int getUnitCell(int m, int n, int unit, int k){
+	int N = m*n;
+
+	if (unit < N) {
+		return unit*N + k;
+	}
+	if (unit < 2*N) {
+		return k*N + unit - N;
+	}
+	unit -= 2*N;
+	return ((unit / m)*m + k / n)*N + (unit % m)*n + k % n;
+}
+
+int ** createBoardSnapshot(int ** board, int N){
+	int i;
+	int ** snapshot = (int **) malloc(N*sizeof(int *));
+	int * cells = (int *) malloc((long) N*N*sizeof(int));
+
+	if (snapshot == NULL || cells == NULL) {
+		free(snapshot);
+		free(cells);
+		return NULL;
+	}
+	for (i = 0; i < N; i++) {
+		snapshot[i] = cells + (long) i*N;
+		if (board != NULL) {
+			memcpy(snapshot[i], board[i], N*sizeof(int));
+		}
+		else {
+			memset(snapshot[i], 0, N*sizeof(int));
 		}
 	}
+	return snapshot;
+}
+
+void freeBoardSnapshot(int ** snapshot){
+	if (snapshot == NULL) {
+		return;
+	}
+	free(snapshot[0]);
+	free(snapshot);
+}
+
+void setSolverDeadline(SolverDeadline * deadline, long budgetMillis){
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	deadline->startSec = (long) now.tv_sec;
+	deadline->startNsec = now.tv_nsec;
+	deadline->budgetMillis = budgetMillis > 0 ? budgetMillis : 0;
+}
+
+int isSolverDeadlinePassed(void * deadline){
+	SolverDeadline * limit = (SolverDeadline *) deadline;
+
+	if (limit == NULL || limit->budgetMillis == 0) {
+		return 0;
+	}
+	return getSolverElapsedMillis(limit) >= limit->budgetMillis;
+}
+
+double getSolverElapsedSeconds(SolverDeadline * deadline){
+	struct timespec now;
 
-	/* free stack and return result*/
-	freeStack(stack);
-	return cntSoultions;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double) ((long) now.tv_sec - deadline->startSec) + (now.tv_nsec - deadline->startNsec) / 1e9;
 }
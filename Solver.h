@@ -3,22 +3,78 @@
 * FILES NAMES :        Solver.c , Solver.h
 *
 * DESCRIPTION :
-*       Solve the sudoku game in different techniques using ILP solver algorithm (Gurobi) and Exhaustive backtracking solver.
+*       The sudoku solving core (libsudoku): solve the sudoku game in different techniques using
+*       ILP solver algorithm (Gurobi) and Exhaustive backtracking solver.
+*       The core is reentrant and free of console I/O, so the game (and any other program) can run it
+*       from several threads at once.
 *
 *
 * PUBLIC FUNCTIONS :
-*      int solveBoardWithILP(Game* game)
-*      int cntNumSolutions(Game* game)
+*      int solveBoardWithILP(int ** board, int m, int n, int ** solution)
+*      int solveBoardWithILPUntil(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg, int ** solution)
+*      int solveBoardWithILPWithin(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg,
+*                                  SolverDeadline * deadline, int ** solution)
+*      int solveBoardWithBacktracking(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg, int ** solution)
+*      int cntNumSolutions(int ** board, int m, int n, int * numOfSolutions)
+*      int cntNumSolutionsUntil(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg, int * numOfSolutions)
+*      int propagateBoard(int ** board, int m, int n, int ** solution)
+*      int getUnitCell(int m, int n, int unit, int k)
+*      int ** createBoardSnapshot(int ** board, int N)
+*      void freeBoardSnapshot(int ** snapshot)
+*      void setSolverDeadline(SolverDeadline * deadline, long budgetMillis)
+*      int isSolverDeadlinePassed(void * deadline)
+*      double getSolverElapsedSeconds(SolverDeadline * deadline)
 *
 * NOTES :
-*   1. cntNumSolutions using Exhaustive BT with an implicit stack instead of recursion.
-*      The function returns the game num of solutions, without changing the board.
-*   2. solveBoardWithILP using the ILP solver algorithm (Gurobi) to check if the board is solvable.
-*      In this case, the return value indicate if the solver has worked or there was a problem during the execution.
-*      The function set isSolvable to 1 if it the game was found solvable in the ILP solver run.
+*   1. The core functions work on boards they don't own: the board is only read, results are written to
+*      buffers supplied by the caller, and there is no shared state between calls.
+*      They never print and never exit, every failure is returned as a sudokuResult code.
+*   2. cntNumSolutions using Exhaustive BT with an explicit stack instead of recursion,
+*      on its own copy of the board.
+*   3. solveBoardWithILP using the ILP solver algorithm (Gurobi) to check if the board is solvable,
+*      and fills the solution board if it is.
+*      solveBoardWithBacktracking is the native alternative: a backtracking search for a single solution,
+*      that always fills the empty cell with the fewest legal values next.
+*   4. Boards are int ** of N*N cells (N = m*n, blocks of m rows and n columns), 0 is an empty cell.
+*      createBoardSnapshot makes a copy of a board that can be passed to the core while the original keeps changing.
+*   5. Solver.o is archived as libsudoku.a (see the makefile), which is linked with the Gurobi library.
+*      The portfolio solver (Portfolio.h), which races the solvers against each other, is part of the library too.
+*   6. A SolverDeadline is a wall clock budget (on the monotonic clock) for a core call.
+*      The ILP solver gets the time that is left as the Gurobi TimeLimit, and the native searches check the deadline
+*      through their stop condition (isSolverDeadlinePassed has the shouldStop signature), every SOLVER_STOP_CHECK_INTERVAL steps.
+*   7. Every ILP solve starts with a propagation pass (propagateBoard): a board it finds a contradiction in is unsolvable,
+*      and a board it fills completely is solved, both without building a Gurobi model.
 *
 ************************************/
 
+/*
+ * sudokuResult is the result of a core function:
+ * 1. SUDOKU_OK - the function succeeded (for the ILP solver - the board is solvable)
+ * 2. SUDOKU_UNSOLVABLE - the ILP solver found that the board has no solution
+ * 3. SUDOKU_SOLVER_ERROR - the ILP solver (Gurobi) failed
+ * 4. SUDOKU_OUT_OF_MEMORY - a memory allocation failed
+ * 5. SUDOKU_STOPPED - the caller stop condition stopped the function before it finished
+ * 6. SUDOKU_TIMEOUT - the function deadline passed before it finished
+ * 7. SUDOKU_UNDECIDED - propagation alone couldn't tell whether the board is solvable
+ */
+typedef enum sudokuResult {
+	SUDOKU_OK = 0, SUDOKU_UNSOLVABLE, SUDOKU_SOLVER_ERROR, SUDOKU_OUT_OF_MEMORY, SUDOKU_STOPPED, SUDOKU_TIMEOUT,
+	SUDOKU_UNDECIDED} sudokuResult;
+
+/* number of backtracking steps between two checks of the caller stop condition */
+#define SOLVER_STOP_CHECK_INTERVAL 4096
+
+/*
+ * SolverDeadline is a wall clock budget of core calls (see setSolverDeadline):
+ * 1. startSec, startNsec - the monotonic clock time the budget started
+ * 2. budgetMillis - the budget in milliseconds, 0 for no deadline
+ */
+typedef struct SolverDeadline{
+	long startSec;
+	long startNsec;
+	long budgetMillis;
+}SolverDeadline;
+
  /*
   * Copyright 2017, Gurobi Optimization, Inc.
   * Note: This code is based on an example from the gurubi website
@@ -34,16 +90,39 @@
   *  3. Each value is used exactly once per column (sum_j x[i,j,k] = 1)
   *  4. Each value is used exactly once per mxn block (sum_grid x[i,j,k] = 1)
   *
-  *  The function gets a pointer to the game and returns an int
-  *  which indicates if the ILP solution worked without a problem (1)
-  *  or there was a problem during the execution (0).
-  *
-  * In case there wasn't a problem with the execution -
-  * the function also changes game isSolvable attribute
-  * to 1 in case there is an optimal solution or to 0 if there isn't such solution
+  *  The function gets the board and its block dimensions m, n and returns:
+  *  SUDOKU_OK if there is an optimal solution - the solution values are written to solution
+  *  (an N*N board supplied by the caller, or NULL if only solvability is needed),
+  *  SUDOKU_UNSOLVABLE if there isn't such solution (solution isn't changed),
+  *  or SUDOKU_SOLVER_ERROR / SUDOKU_OUT_OF_MEMORY if there was a problem during the execution.
 */
 
-int solveBoardWithILP(Game* game);
+int solveBoardWithILP(int ** board, int m, int n, int ** solution);
+
+/*
+ * same as solveBoardWithILP, but while the model is optimized shouldStop(stopArg) is called periodically
+ * (from a Gurobi callback), and once it returns 1 the optimization is terminated and SUDOKU_STOPPED is returned.
+ * shouldStop may be NULL (the optimization is never stopped)
+ */
+int solveBoardWithILPUntil(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg, int ** solution);
+
+/*
+ * same as solveBoardWithILPUntil, but the optimization is also limited by the deadline:
+ * the time left is the Gurobi TimeLimit, and SUDOKU_TIMEOUT is returned once the deadline passed.
+ * deadline may be NULL (no deadline)
+ */
+int solveBoardWithILPWithin(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg,
+		SolverDeadline * deadline, int ** solution);
+
+/*
+ * finds a single solution of the board with backtracking (explicit stack, on its own copy of the board),
+ * trying the empty cell with the fewest legal values first at every step.
+ * returns SUDOKU_OK and writes the solution to solution (unless it is NULL) if the board is solvable,
+ * SUDOKU_UNSOLVABLE if it isn't (or it has a value outside 1..N or two equal values in a row, column or block),
+ * or SUDOKU_OUT_OF_MEMORY.
+ * shouldStop is checked as in cntNumSolutionsUntil (SUDOKU_STOPPED is returned once it returns 1), and may be NULL
+ */
+int solveBoardWithBacktracking(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg, int ** solution);
 
 /*
  *  The exhaustive backtracking algorithm doesn't finish when the last cell is filled with a legal value.
@@ -51,9 +130,63 @@ int solveBoardWithILP(Game* game);
  *  or backtrack if necessary in order to retrieve other potential solutions.
  *  Thus, the algorithm exhausts all possible values for all empty cells of the board, counting all solutions found in this process. 
  *  Once the algorithm backtracks from the 1st empty cell, the algorithm is finished, 
- *  and the counter contains the number of different solutions available for the current board and the function returns it.
+ *  and the counter contains the number of different solutions available for the current board.
  *  The exhaustive backtracking algorithm  is implemented with an explicit stack for simulating recursion, rather than through recursive calls.
+ *  The board itself isn't changed. The counter is put in numOfSolutions, and the function returns SUDOKU_OK
+ *  (or SUDOKU_OUT_OF_MEMORY, and numOfSolutions isn't set).
  */
-int cntNumSolutions(Game* game);
+int cntNumSolutions(int ** board, int m, int n, int * numOfSolutions);
 
+/*
+ * same as cntNumSolutions, but every SOLVER_STOP_CHECK_INTERVAL backtracking steps shouldStop(stopArg) is called,
+ * and once it returns 1 the search stops and SUDOKU_STOPPED is returned (numOfSolutions isn't set).
+ * shouldStop may be NULL (the search is never stopped)
+ */
+int cntNumSolutionsUntil(int ** board, int m, int n, int (*shouldStop)(void * arg), void * stopArg, int * numOfSolutions);
 
+/*
+ * runs constraint propagation on a copy of the board until it makes no more progress:
+ * an empty cell with a single legal value gets it (naked single), and so does the single empty cell of a row,
+ * column or block where a missing value can go (hidden single).
+ * returns:
+ * 1. SUDOKU_UNSOLVABLE - a contradiction was found: a value outside 1..N, two equal values in a row, column or block,
+ *    an empty cell with no legal value, or a missing value with no place left in a row, column or block.
+ * 2. SUDOKU_OK - the board was filled completely, and the solution is written to solution (unless it is NULL).
+ * 3. SUDOKU_UNDECIDED - otherwise (solution isn't changed).
+ * 4. SUDOKU_OUT_OF_MEMORY - a memory allocation failed.
+ */
+int propagateBoard(int ** board, int m, int n, int ** solution);
+
+/*
+ * returns the number (row*N + col) of cell k (0 to N-1) of unit number unit:
+ * units 0 to N-1 are the rows, N to 2N-1 the columns and 2N to 3N-1 the blocks (row by row),
+ * and the cells of a block are numbered row by row too
+ */
+int getUnitCell(int m, int n, int unit, int k);
+
+/*
+ * allocates a copy of the N*N board (or an empty board if board is NULL) and returns it.
+ * returns NULL if the memory cannot be allocated
+ */
+int ** createBoardSnapshot(int ** board, int N);
+
+/*
+ * frees a board allocated by createBoardSnapshot (NULL is ignored)
+ */
+void freeBoardSnapshot(int ** snapshot);
+
+/*
+ * starts a budget of budgetMillis milliseconds from now in deadline (budgetMillis <= 0 for no deadline)
+ */
+void setSolverDeadline(SolverDeadline * deadline, long budgetMillis);
+
+/*
+ * returns 1 iff the deadline (a SolverDeadline *) passed, 0 if it didn't or there is no deadline (or it is NULL).
+ * it can be passed as the shouldStop condition of the core functions
+ */
+int isSolverDeadlinePassed(void * deadline);
+
+/*
+ * returns the seconds that passed since the deadline budget started
+ */
+double getSolverElapsedSeconds(SolverDeadline * deadline);
@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "UnitCheck.h"
+#include "mainAux.h"
+#ifdef UNIT_CHECK_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
+/***** UnitCheck inner functions *****/
+
+/*
+ * adds the cell value to the masks of its unit (an empty cell or a value outside 1..N is ignored):
+ * once - the values seen in the unit, twice - the values seen more than once.
+ * the masks are bitsets of unsigned long words
+ */
+void addToUnitMasks(unsigned long * once, unsigned long * twice, int value, int N) {
+	unsigned long bit;
+	int word;
+
+	if (value == 0 || value < -N || value > N) {
+		return;
+	}
+	value = abs(value) - 1;
+	word = value / UNIT_CHECK_WORD_BITS;
+	bit = 1UL << (value % UNIT_CHECK_WORD_BITS);
+	twice[word] |= once[word] & bit;
+	once[word] |= bit;
+}
+
+/*
+ * marks the cell if its value is in the duplicate mask twice (a bitset of unsigned long words).
+ * a value outside 1..N is never marked
+ */
+void markIfDuplicate(int * cell, unsigned long * twice, int N) {
+	int value;
+
+	if (*cell == 0 || *cell < -N || *cell > N) {
+		return;
+	}
+	value = abs(*cell) - 1;
+	if (((twice[value / UNIT_CHECK_WORD_BITS] >> (value % UNIT_CHECK_WORD_BITS)) & 1UL) == 1) {
+		*cell = -(value + 1);
+	}
+}
+
+/*
+ * the scalar kernel: marks the duplicate values of every row, column and block of the board
+ */
+void markDuplicatesScalar(int ** board, int m, int n) {
+	int N = m*n;
+	int words = (N + UNIT_CHECK_WORD_BITS - 1) / UNIT_CHECK_WORD_BITS;
+	unsigned long * once;
+	unsigned long * twice;
+	int i;
+	int j;
+	int r;
+	int c;
+
+	/* the masks of all the columns, column j masks start at word j*words */
+	once = (unsigned long *) calloc((long) 2*N*words, sizeof(unsigned long));
+	if (once == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	twice = once + (long) N*words;
+
+	/* rows */
+	for (i = 0; i < N; i++) {
+		memset(once, 0, words*sizeof(unsigned long));
+		memset(twice, 0, words*sizeof(unsigned long));
+		for (j = 0; j < N; j++) {
+			addToUnitMasks(once, twice, board[i][j], N);
+		}
+		for (j = 0; j < N; j++) {
+			markIfDuplicate(&board[i][j], twice, N);
+		}
+	}
+
+	/* columns, all together */
+	memset(once, 0, (long) 2*N*words*sizeof(unsigned long));
+	for (i = 0; i < N; i++) {
+		for (j = 0; j < N; j++) {
+			addToUnitMasks(once + (long) j*words, twice + (long) j*words, board[i][j], N);
+		}
+	}
+	for (i = 0; i < N; i++) {
+		for (j = 0; j < N; j++) {
+			markIfDuplicate(&board[i][j], twice + (long) j*words, N);
+		}
+	}
+
+	/* blocks, from the top left cell of every block */
+	for (i = 0; i < N; i += m) {
+		for (j = 0; j < N; j += n) {
+			memset(once, 0, words*sizeof(unsigned long));
+			memset(twice, 0, words*sizeof(unsigned long));
+			for (r = i; r < i + m; r++) {
+				for (c = j; c < j + n; c++) {
+					addToUnitMasks(once, twice, board[r][c], N);
+				}
+			}
+			for (r = i; r < i + m; r++) {
+				for (c = j; c < j + n; c++) {
+					markIfDuplicate(&board[r][c], twice, N);
+				}
+			}
+		}
+	}
+	free(once);
+}
+
+#ifdef UNIT_CHECK_HAVE_AVX2
+
+/*
+ * returns the value bit of a cell of the AVX2 kernel - bit v-1 for value v (marked or not),
+ * and no bit for an empty cell or a value outside 1..N
+ */
+unsigned int getValueBit(int value, int N) {
+	if (value == 0 || value < -N || value > N) {
+		return 0;
+	}
+	return 1U << (abs(value) - 1);
+}
+
+/*
+ * returns the value bits of 8 cells (see getValueBit), maxValue holds N in every lane.
+ * an empty cell gets no bit since its shift count is -1, so the shift gives 0,
+ * and the lanes of the values above N are cleared
+ */
+__attribute__((target("avx2")))
+__m256i getValueBitsAVX2(__m256i cells, __m256i maxValue) {
+	__m256i one = _mm256_set1_epi32(1);
+	__m256i values = _mm256_abs_epi32(cells);
+
+	return _mm256_andnot_si256(_mm256_cmpgt_epi32(values, maxValue),
+			_mm256_sllv_epi32(one, _mm256_sub_epi32(values, one)));
+}
+
+/*
+ * marks the cells of the 8 cells whose value bits are in their duplicate masks (one mask per cell)
+ */
+__attribute__((target("avx2")))
+__m256i markDuplicatesAVX2(__m256i cells, __m256i twice, __m256i maxValue) {
+	__m256i zero = _mm256_setzero_si256();
+	__m256i notDuplicate = _mm256_cmpeq_epi32(_mm256_and_si256(getValueBitsAVX2(cells, maxValue), twice), zero);
+
+	return _mm256_blendv_epi8(_mm256_sub_epi32(zero, _mm256_abs_epi32(cells)), cells, notDuplicate);
+}
+
+/*
+ * adds len consecutive cells of a unit to the unit masks (see addToUnitMasks), 8 cells at a time
+ */
+__attribute__((target("avx2")))
+void addRunToUnitMasksAVX2(int * cells, int len, int N, unsigned int * once, unsigned int * twice) {
+	__m256i maxValue = _mm256_set1_epi32(N);
+	__m256i laneOnce = _mm256_setzero_si256();
+	__m256i laneTwice = _mm256_setzero_si256();
+	__m256i bits;
+	unsigned int lanesOnce[8];
+	unsigned int lanesTwice[8];
+	unsigned int bit;
+	int k;
+
+	/* every lane keeps the masks of the cells it saw */
+	for (k = 0; k + 8 <= len; k += 8) {
+		bits = getValueBitsAVX2(_mm256_loadu_si256((__m256i *) (cells + k)), maxValue);
+		laneTwice = _mm256_or_si256(laneTwice, _mm256_and_si256(laneOnce, bits));
+		laneOnce = _mm256_or_si256(laneOnce, bits);
+	}
+	/* then the lanes are merged: a value seen by two lanes is seen twice */
+	_mm256_storeu_si256((__m256i *) lanesOnce, laneOnce);
+	_mm256_storeu_si256((__m256i *) lanesTwice, laneTwice);
+	for (k = 0; k < 8; k++) {
+		*twice |= lanesTwice[k] | (*once & lanesOnce[k]);
+		*once |= lanesOnce[k];
+	}
+	for (k = len - len % 8; k < len; k++) {
+		bit = getValueBit(cells[k], N);
+		*twice |= *once & bit;
+		*once |= bit;
+	}
+}
+
+/*
+ * marks the cells of len consecutive cells of a unit whose value is in the unit duplicate mask twice, 8 cells at a time
+ */
+__attribute__((target("avx2")))
+void markRunAVX2(int * cells, int len, int N, unsigned int twice) {
+	__m256i mask = _mm256_set1_epi32((int) twice);
+	__m256i maxValue = _mm256_set1_epi32(N);
+	int k;
+
+	for (k = 0; k + 8 <= len; k += 8) {
+		_mm256_storeu_si256((__m256i *) (cells + k),
+				markDuplicatesAVX2(_mm256_loadu_si256((__m256i *) (cells + k)), mask, maxValue));
+	}
+	for (; k < len; k++) {
+		if ((getValueBit(cells[k], N) & twice) != 0) {
+			cells[k] = -abs(cells[k]);
+		}
+	}
+}
+
+/*
+ * the AVX2 kernel (N <= UNIT_CHECK_AVX2_MAX_N): marks the duplicate values of every row, column and block of the board.
+ * the rows and the blocks are checked 8 cells at a time, and the columns 8 columns at a time
+ */
+__attribute__((target("avx2")))
+void markDuplicatesWithAVX2(int ** board, int m, int n) {
+	int N = m*n;
+	unsigned int once[UNIT_CHECK_AVX2_MAX_N];
+	unsigned int twice[UNIT_CHECK_AVX2_MAX_N];
+	__m256i maxValue = _mm256_set1_epi32(N);
+	__m256i laneOnce;
+	__m256i laneTwice;
+	__m256i bits;
+	unsigned int bit;
+	int i;
+	int j;
+	int r;
+
+	/* rows */
+	for (i = 0; i < N; i++) {
+		once[0] = 0;
+		twice[0] = 0;
+		addRunToUnitMasksAVX2(board[i], N, N, &once[0], &twice[0]);
+		markRunAVX2(board[i], N, N, twice[0]);
+	}
+
+	/* columns, all together: column j masks are once[j] and twice[j] */
+	memset(once, 0, sizeof(once));
+	memset(twice, 0, sizeof(twice));
+	for (i = 0; i < N; i++) {
+		for (j = 0; j + 8 <= N; j += 8) {
+			laneOnce = _mm256_loadu_si256((__m256i *) (once + j));
+			laneTwice = _mm256_loadu_si256((__m256i *) (twice + j));
+			bits = getValueBitsAVX2(_mm256_loadu_si256((__m256i *) (board[i] + j)), maxValue);
+			_mm256_storeu_si256((__m256i *) (twice + j), _mm256_or_si256(laneTwice, _mm256_and_si256(laneOnce, bits)));
+			_mm256_storeu_si256((__m256i *) (once + j), _mm256_or_si256(laneOnce, bits));
+		}
+		for (; j < N; j++) {
+			bit = getValueBit(board[i][j], N);
+			twice[j] |= once[j] & bit;
+			once[j] |= bit;
+		}
+	}
+	for (i = 0; i < N; i++) {
+		for (j = 0; j + 8 <= N; j += 8) {
+			_mm256_storeu_si256((__m256i *) (board[i] + j), markDuplicatesAVX2(
+					_mm256_loadu_si256((__m256i *) (board[i] + j)), _mm256_loadu_si256((__m256i *) (twice + j)),
+					maxValue));
+		}
+		for (; j < N; j++) {
+			markRunAVX2(board[i] + j, 1, N, twice[j]);
+		}
+	}
+
+	/* blocks, from the top left cell of every block */
+	for (i = 0; i < N; i += m) {
+		for (j = 0; j < N; j += n) {
+			once[0] = 0;
+			twice[0] = 0;
+			for (r = i; r < i + m; r++) {
+				addRunToUnitMasksAVX2(board[r] + j, n, N, &once[0], &twice[0]);
+			}
+			for (r = i; r < i + m; r++) {
+				markRunAVX2(board[r] + j, n, N, twice[0]);
+			}
+		}
+	}
+}
+
+#endif
+
+/*
+ * returns the kernel for a board of size N on this processor
+ */
+int getUnitCheckKernel(int N) {
+#ifdef UNIT_CHECK_HAVE_AVX2
+	if (N <= UNIT_CHECK_AVX2_MAX_N && __builtin_cpu_supports("avx2")) {
+		return UNIT_CHECK_AVX2;
+	}
+#endif
+	(void) N;
+	return UNIT_CHECK_SCALAR;
+}
+
+
+/***** UnitCheck.h implementation *****/
+
+int markDuplicateValues(int ** board, int m, int n){
+	int N = m*n;
+	int numOfMarkedCells = 0;
+	int i;
+	int j;
+
+#ifdef UNIT_CHECK_HAVE_AVX2
+	if (getUnitCheckKernel(N) == UNIT_CHECK_AVX2){
+		markDuplicatesWithAVX2(board, m, n);
+	}
+	else{
+		markDuplicatesScalar(board, m, n);
+	}
+#else
+	markDuplicatesScalar(board, m, n);
+#endif
+
+	for (i = 0; i < N; i++){
+		for (j = 0; j < N; j++){
+			numOfMarkedCells += board[i][j] < 0;
+		}
+	}
+	return numOfMarkedCells;
+}
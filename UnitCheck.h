@@ -0,0 +1,49 @@
+/************************************
+* FILES NAMES :        UnitCheck.c , UnitCheck.h
+*
+* DESCRIPTION :
+*       Board validation kernels: find and mark the cells whose value repeats in their row, column or block,
+*       with a single pass over every unit (row, column or block) of the board.
+*
+* PUBLIC FUNCTIONS :
+*       int markDuplicateValues(int ** board, int m, int n)
+*
+* NOTES :
+*       1. Every unit is checked with two bitsets of the values (bit v-1 for value v): the values seen in the unit,
+*          and the values seen more than once in it - the unit duplicate mask. A second pass over the unit marks
+*          the cells whose value is in the duplicate mask. The whole board takes O(N*N) steps,
+*          instead of a scan of the row, the column and the block of every filled cell.
+*       2. The columns are checked together, row by row, each with its own masks, so the board is read in memory order.
+*       3. There are two kernels, chosen at runtime by the board size and the processor:
+*           a. UNIT_CHECK_SCALAR - portable C, with bitsets of unsigned long words, for any board size.
+*           b. UNIT_CHECK_AVX2 - AVX2 instructions (8 cells at once), for boards of up to UNIT_CHECK_AVX2_MAX_N*UNIT_CHECK_AVX2_MAX_N,
+*              whose masks fit a 32 bit lane. It is used on x86 processors that support AVX2, and left out of the build
+*              on other compilers and processors, or when UNIT_CHECK_NO_SIMD is defined.
+*
+************************************/
+
+/* the AVX2 kernel is built with GCC compatible compilers for x86 processors */
+#if !defined(UNIT_CHECK_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UNIT_CHECK_HAVE_AVX2
+#endif
+
+/* max board size of the AVX2 kernel (a duplicate mask is a 32 bit lane) */
+#define UNIT_CHECK_AVX2_MAX_N 32
+
+/* number of bits in a word of the scalar kernel bitsets */
+#define UNIT_CHECK_WORD_BITS ((int) (8 * sizeof(unsigned long)))
+
+/*
+ * the unit check kernels (see the notes above)
+ */
+typedef enum unitCheckKernel {
+	UNIT_CHECK_SCALAR, UNIT_CHECK_AVX2} unitCheckKernel;
+
+/*
+ * marks every cell of the N*N board (blocks of m rows and n columns) whose value repeats in its row,
+ * column or block: the cell value is made negative, as the game marks erroneous cells.
+ * the board values may be marked already (only their absolute values are checked), 0 is an empty cell.
+ * a value outside 1..N is ignored: it is never marked and doesn't mark other cells.
+ * returns the number of marked cells on the board
+ */
+int markDuplicateValues(int ** board, int m, int n);
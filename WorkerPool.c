@@ -0,0 +1,155 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "WorkerPool.h"
+#include "mainAux.h"
+
+/***** WorkerPool inner functions *****/
+
+/*
+ * the worker thread loop: take the first job from the queue and run it,
+ * until the pool is stopping and the queue is empty
+ */
+void * runWorker(void * arg){
+	WorkerPool * pool = (WorkerPool *) arg;
+	PoolJob * job;
+
+	while (1){
+		pthread_mutex_lock(&pool->lock);
+		while (pool->first == NULL && pool->stopping == 0){
+			pthread_cond_wait(&pool->jobAdded, &pool->lock);
+		}
+		if (pool->first == NULL){
+			pthread_mutex_unlock(&pool->lock);
+			return NULL;
+		}
+		job = pool->first;
+		pool->first = job->next;
+		if (pool->first == NULL){
+			pool->last = NULL;
+		}
+		pthread_mutex_unlock(&pool->lock);
+
+		job->run(job->arg);
+
+		pthread_mutex_lock(&pool->lock);
+		job->done = 1;
+		pthread_cond_broadcast(&pool->jobDone);
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+
+
+/***** WorkerPool.h implementation *****/
+
+WorkerPool * createWorkerPool(int numOfWorkers){
+	WorkerPool * pool;
+	int k;
+
+	pool = (WorkerPool *) malloc(sizeof(WorkerPool));
+	if (pool == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	pool->workers = (pthread_t *) malloc(numOfWorkers * sizeof(pthread_t));
+	if (pool->workers == NULL){
+		printMemoryAllocationError();
+		exit(0);
+	}
+	pool->numOfWorkers = 0;
+	pool->first = NULL;
+	pool->last = NULL;
+	pool->stopping = 0;
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->jobAdded, NULL);
+	pthread_cond_init(&pool->jobDone, NULL);
+
+	for (k = 0; k < numOfWorkers; k++){
+		if (pthread_create(&pool->workers[k], NULL, runWorker, pool) != 0){
+			freeWorkerPool(pool);
+			return NULL;
+		}
+		pool->numOfWorkers++;
+	}
+	return pool;
+}
+
+void freeWorkerPool(WorkerPool * pool){
+	int k;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->stopping = 1;
+	pthread_cond_broadcast(&pool->jobAdded);
+	pthread_mutex_unlock(&pool->lock);
+
+	for (k = 0; k < pool->numOfWorkers; k++){
+		pthread_join(pool->workers[k], NULL);
+	}
+
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->jobAdded);
+	pthread_cond_destroy(&pool->jobDone);
+	free(pool->workers);
+	free(pool);
+}
+
+void submitPoolJob(WorkerPool * pool, PoolJob * job, void (*run)(void * arg), void * arg){
+	job->run = run;
+	job->arg = arg;
+	job->done = 0;
+	job->next = NULL;
+
+	pthread_mutex_lock(&pool->lock);
+	if (pool->last == NULL){
+		pool->first = job;
+	}
+	else {
+		pool->last->next = job;
+	}
+	pool->last = job;
+	pthread_cond_signal(&pool->jobAdded);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+void waitPoolJob(WorkerPool * pool, PoolJob * job){
+	pthread_mutex_lock(&pool->lock);
+	while (job->done == 0){
+		pthread_cond_wait(&pool->jobDone, &pool->lock);
+	}
+	pthread_mutex_unlock(&pool->lock);
+}
+
+void runPoolJob(WorkerPool * pool, PoolJob * job, void (*run)(void * arg), void * arg){
+	submitPoolJob(pool, job, run, arg);
+	waitPoolJob(pool, job);
+}
+
+int removePoolJob(WorkerPool * pool, PoolJob * job){
+	PoolJob * prev = NULL;
+	PoolJob * curr;
+
+	pthread_mutex_lock(&pool->lock);
+	for (curr = pool->first; curr != NULL && curr != job; curr = curr->next){
+		prev = curr;
+	}
+	if (curr == NULL){
+		pthread_mutex_unlock(&pool->lock);
+		return 0;
+	}
+	if (prev == NULL){
+		pool->first = job->next;
+	}
+	else {
+		prev->next = job->next;
+	}
+	if (pool->last == job){
+		pool->last = prev;
+	}
+	job->next = NULL;
+	job->done = 1;
+	pthread_cond_broadcast(&pool->jobDone);
+	pthread_mutex_unlock(&pool->lock);
+	return 1;
+}
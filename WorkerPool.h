@@ -0,0 +1,87 @@
+/************************************
+* FILES NAMES :        WorkerPool.c , WorkerPool.h
+*
+* DESCRIPTION :
+*       A fixed size pool of worker threads that run jobs from a shared FIFO queue.
+*       The server sessions send their solver commands (ILP and exhaustive backtracking) to one pool,
+*       so the number of solver runs at any moment is bounded by the number of workers, however many clients are connected.
+*
+* PUBLIC FUNCTIONS :
+*       WorkerPool * createWorkerPool(int numOfWorkers)
+*       void freeWorkerPool(WorkerPool * pool)
+*       void submitPoolJob(WorkerPool * pool, PoolJob * job, void (*run)(void * arg), void * arg)
+*       void waitPoolJob(WorkerPool * pool, PoolJob * job)
+*       void runPoolJob(WorkerPool * pool, PoolJob * job, void (*run)(void * arg), void * arg)
+*       int removePoolJob(WorkerPool * pool, PoolJob * job)
+*
+* NOTES :
+*       1. Jobs are owned by the caller: a submitted job must stay valid until waitPoolJob returns
+*          (or the pool is freed), the pool only links it into the queue.
+*       2. The files that include WorkerPool.h must include pthread.h before it.
+*
+************************************/
+
+/*
+ * PoolJob is a single job of the pool:
+ * 1. run, arg - the job function and its argument
+ * 2. done - 1 iff the job was already run by a worker
+ * 3. next - the next job in the pool queue
+ */
+typedef struct PoolJob{
+	void (*run)(void * arg);
+	void * arg;
+	int done;
+	struct PoolJob * next;
+}PoolJob;
+
+/*
+ * WorkerPool struct contains:
+ * 1. workers, numOfWorkers - the worker threads
+ * 2. lock - protects the queue, the jobs done flags and stopping
+ * 3. jobAdded - signaled when a job is added to the queue (or the pool is stopping)
+ * 4. jobDone - broadcast when a job is done
+ * 5. first, last - the queue of the jobs that weren't taken by a worker yet
+ * 6. stopping - 1 iff the pool is being freed
+ */
+typedef struct WorkerPool{
+	pthread_t * workers;
+	int numOfWorkers;
+	pthread_mutex_t lock;
+	pthread_cond_t jobAdded;
+	pthread_cond_t jobDone;
+	PoolJob * first;
+	PoolJob * last;
+	int stopping;
+}WorkerPool;
+
+/*
+ * allocates a new pool, starts its numOfWorkers worker threads and returns a pointer to it.
+ * returns NULL if the worker threads cannot be started
+ */
+WorkerPool * createWorkerPool(int numOfWorkers);
+
+/*
+ * runs the jobs left in the queue, stops the worker threads and frees the pool
+ */
+void freeWorkerPool(WorkerPool * pool);
+
+/*
+ * initializes job with run and arg, and adds it to the end of the pool queue
+ */
+void submitPoolJob(WorkerPool * pool, PoolJob * job, void (*run)(void * arg), void * arg);
+
+/*
+ * waits until a worker has run the submitted job
+ */
+void waitPoolJob(WorkerPool * pool, PoolJob * job);
+
+/*
+ * runs run(arg) on one of the pool workers and waits until it is done
+ */
+void runPoolJob(WorkerPool * pool, PoolJob * job, void (*run)(void * arg), void * arg);
+
+/*
+ * removes the submitted job from the queue if no worker took it yet: the job is then done without being run.
+ * returns 1 iff the job was removed
+ */
+int removePoolJob(WorkerPool * pool, PoolJob * job);
@@ -1,7 +1,126 @@
-
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "WorkerPool.h"
 #include "GameFlow.h"
+#include "Server.h"
+#include "mainAux.h"
+
+/*
+ * parses the seed of the --seed option into seed.
+ * returns 1 iff str is a non negative decimal number
+ */
+int parseSeed(char * str, unsigned long * seed){
+	char * end;
+
+	if (str[0] < '0' || str[0] > '9'){
+		return 0;
+	}
+	*seed = strtoul(str, &end, 10);
+	return *end == '\0';
+}
+
+/*
+ * runs the sudoku game.
+ * options:
+ * 1. -q - quiet mode: no prompts and no automatic board prints (print_board still prints the board)
+ * 2. -f FILE - batch mode: read the commands from FILE instead of the standard input
+ * 3. -j - protocol mode: a JSON line reply for every command (see Protocol.h)
+ * 4. -s SOCKET - server mode: a game session for every connection to the Unix socket SOCKET (see Server.h)
+ * 5. -w N - number of solver workers shared by the server sessions
+ * 6. -c SOCKET - client mode: play through the server listening on SOCKET
+ * 7. -n - no speculative solving of the board in the background (see Game.h)
+ * 8. --seed S - seed the game random generator with S, so generate is reproducible (see Random.h)
+ * 9. -p N - keep N pre-generated puzzles for each recent generate request (see PuzzlePool.h)
+ * 10. -g FILE - keep the statistics generate auto learns from in FILE (see GenerateStats.h)
+ * 11. -m N - keep at most N moves in the undo-redo moves log (see MoveLog.h)
+ * the exit status is EXIT_STATUS_SUCCESS iff no command failed (see GameFlow.h)
+ */
+int main(int argc, char * argv[]){
+	FILE * commandsFile = stdin;
+	char * serverSocket = NULL;
+	char * clientSocket = NULL;
+	int numOfWorkers = DEFAULT_NUM_OF_SOLVER_WORKERS;
+	GameOptions options;
+	int status;
+	int i;
+
+	options.quiet = 0;
+	options.protocolMode = 0;
+	options.speculate = 1;
+	options.hasSeed = 0;
+	options.seed = 0;
+	options.poolSize = 0;
+	options.generateStatsPath = NULL;
+	options.generateStats = NULL;
+	options.maxMoves = 0;
+
+	for (i = 1; i < argc; i++){
+		if (strcmp(argv[i], QUIET_OPTION) == 0){
+			options.quiet = 1;
+		}
+		else if (strcmp(argv[i], PROTOCOL_OPTION) == 0){
+			options.protocolMode = 1;
+		}
+		else if (strcmp(argv[i], NO_SPECULATION_OPTION) == 0){
+			options.speculate = 0;
+		}
+		else if (strcmp(argv[i], SEED_OPTION) == 0 && i+1 < argc && parseSeed(argv[i+1], &options.seed) == 1){
+			options.hasSeed = 1;
+			i++;
+		}
+		else if (strcmp(argv[i], POOL_OPTION) == 0 && i+1 < argc && atoi(argv[i+1]) > 0){
+			options.poolSize = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], MAX_MOVES_OPTION) == 0 && i+1 < argc && atoi(argv[i+1]) > 0){
+			options.maxMoves = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], GENERATE_STATS_OPTION) == 0 && i+1 < argc && options.generateStatsPath == NULL){
+			options.generateStatsPath = argv[++i];
+		}
+		else if (strcmp(argv[i], SERVER_OPTION) == 0 && i+1 < argc && serverSocket == NULL){
+			serverSocket = argv[++i];
+		}
+		else if (strcmp(argv[i], CLIENT_OPTION) == 0 && i+1 < argc && clientSocket == NULL){
+			clientSocket = argv[++i];
+		}
+		else if (strcmp(argv[i], WORKERS_OPTION) == 0 && i+1 < argc && atoi(argv[i+1]) > 0){
+			numOfWorkers = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], COMMANDS_FILE_OPTION) == 0 && i+1 < argc && commandsFile == stdin){
+			i++;
+			commandsFile = fopen(argv[i], "r");
+			if (commandsFile == NULL){
+				printCommandsFileError(argv[i]);
+				return EXIT_STATUS_USAGE_ERROR;
+			}
+		}
+		else {
+			printUsage(argv[0]);
+			return EXIT_STATUS_USAGE_ERROR;
+		}
+	}
+
+	/* the server, the client and a commands file are different ways to run the game */
+	if ((serverSocket != NULL) + (clientSocket != NULL) + (commandsFile != stdin) > 1){
+		printUsage(argv[0]);
+		if (commandsFile != stdin){
+			fclose(commandsFile);
+		}
+		return EXIT_STATUS_USAGE_ERROR;
+	}
+	if (serverSocket != NULL){
+		return runServer(serverSocket, numOfWorkers, &options);
+	}
+	if (clientSocket != NULL){
+		return runClient(clientSocket);
+	}
+
+	status = runGame(commandsFile, &options, NULL);
 
-int main(){
-    runGame();
-    return 1;
+	if (commandsFile != stdin){
+		fclose(commandsFile);
+	}
+	return status;
 }
@@ -1,123 +1,208 @@
+#define _POSIX_C_SOURCE 200112L
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+#include <stdarg.h>
+#include <pthread.h>
+#include "WorkerPool.h"
+#include "GameFlow.h"
+#include "Server.h"
 #include "mainAux.h"
 
-void SeparatorRow(int N , int m){
-	int k;
-	for (k = 0; k < 4*N+m+1 ; k++){
-		printf(DASH);
+/* the output context of the threads that didn't set their own */
+OutputContext defaultOutputContext = {NULL, NULL, 0};
+
+/* the key of the per thread output context */
+pthread_key_t outputContextKey;
+pthread_once_t outputContextKeyOnce = PTHREAD_ONCE_INIT;
+
+/*
+ * create the per thread output context key (called once)
+ */
+void createOutputContextKey(){
+	pthread_key_create(&outputContextKey, NULL);
+}
+
+/*
+ * returns the stream messages are printed to in the current output context
+ */
+FILE * getMessagesStream(){
+	OutputContext * context = getOutputContext();
+
+	if (context->messages != NULL){
+		return context->messages;
+	}
+	return getOutput();
+}
+
+/*
+ * print a user message (printf format and args) to the messages stream
+ */
+void printMessage(char * format, ...){
+	va_list args;
+
+	va_start(args, format);
+	vfprintf(getMessagesStream(), format, args);
+	va_end(args);
+}
+
+/*
+ * print an error message (printf format and args) to the messages stream and count it
+ */
+void printErrorMessage(char * format, ...){
+	va_list args;
+
+	getOutputContext()->numOfPrintedErrors++;
+	va_start(args, format);
+	vfprintf(getMessagesStream(), format, args);
+	va_end(args);
+}
+
+void initOutputContext(OutputContext * context, FILE * output){
+	context->output = output;
+	context->messages = NULL;
+	context->numOfPrintedErrors = 0;
+}
+
+void setOutputContext(OutputContext * context){
+	pthread_once(&outputContextKeyOnce, createOutputContextKey);
+	pthread_setspecific(outputContextKey, context);
+}
+
+OutputContext * getOutputContext(){
+	OutputContext * context;
+
+	pthread_once(&outputContextKeyOnce, createOutputContextKey);
+	context = (OutputContext *) pthread_getspecific(outputContextKey);
+	if (context == NULL){
+		return &defaultOutputContext;
+	}
+	return context;
+}
+
+FILE * getOutput(){
+	OutputContext * context = getOutputContext();
+
+	if (context->output != NULL){
+		return context->output;
 	}
-	printf(NEW_LINE);
+	return stdout;
+}
+
+void setMessagesOutput(FILE * output){
+	getOutputContext()->messages = output;
+}
+
+int getNumOfPrintedErrors(){
+	return getOutputContext()->numOfPrintedErrors;
 }
 
 void printStartSudokuString(){
-	printf("Sudoku\n------\n");
+	printMessage("Sudoku\n------\n");
 }
 
 void printEnterCommand(){
-	printf("Enter your command:\n");
+	printMessage("Enter your command:\n");
 }
 
 void printInvalidCommandError(){
-	printf("ERROR: invalid command\n");
+	printErrorMessage("ERROR: invalid command\n");
 }
 
 void printInvalidMarkErrorsValError(){
-	printf("Error: the value should be 0 or 1\n");
+	printErrorMessage("Error: the value should be 0 or 1\n");
 }
 
 void printFgetsError(){
-	printf("Error: Fgets Error\n");
+	printErrorMessage("Error: Fgets Error\n");
 }
 
 void printSolveFileAccessError(){
-	printf("Error: File doesn't exist or cannot be opened\n");
+	printErrorMessage("Error: File doesn't exist or cannot be opened\n");
 }
 
 void printEditFileAccessError(){
-	printf("Error: File cannot be opened\n");
+	printErrorMessage("Error: File cannot be opened\n");
 }
 
 void printFileCloseError(){
-	printf("Error: File cannot be closed\n");
+	printErrorMessage("Error: File cannot be closed\n");
 }
 
 void printFileFormatError(){
-	printf("Error: File format is incorrect\n");
+	printErrorMessage("Error: File format is incorrect\n");
 }
 
 void printMemoryAllocationError(){
-	printf( "Error: Memory Allocation Failed\n");
+	printErrorMessage("Error: Memory Allocation Failed\n");
  }
 
 void printBoardValidationError(){
-	printf("Error: board validation failed\n");
+	printErrorMessage("Error: board validation failed\n");
 }
 
  void printFileCreationError(){
-	 printf("Error: File cannot be created or modified\n");
+	 printErrorMessage("Error: File cannot be created or modified\n");
  }
 
  void printValueNotInRangeError(int rangeStart, int rangeEnd){
-     printf("Error: value not in range %d-%d\n",rangeStart, rangeEnd);
+     printErrorMessage("Error: value not in range %d-%d\n",rangeStart, rangeEnd);
  }
 
  void printCellIsFixedError(){
-     printf("Error: cell is fixed\n");
+     printErrorMessage("Error: cell is fixed\n");
  }
 
  void printPuzzleSolvedSuccessfullyMessage(){
-     printf("Puzzle solved successfully\n");
+     printMessage("Puzzle solved successfully\n");
  }
 
  void printPuzzleSolutionErroneous(){
-     printf("Puzzle solution erroneous\n");
+     printMessage("Puzzle solution erroneous\n");
  }
 
 void printSavedToFile(char * filePath){
-	printf( "Saved to: %s\n", filePath);
+	printMessage("Saved to: %s\n", filePath);
 }
 
 void printBoardContainErrors(){
-	printf("Error: board contains erroneous values\n");
+	printErrorMessage("Error: board contains erroneous values\n");
 }
 void printValidationPassed(){
-	printf("Validation passed: board is solvable\n");
+	printMessage("Validation passed: board is solvable\n");
 }
 
 void printValidationFailed(){
-	printf("Validation failed: board is unsolvable\n");
+	printMessage("Validation failed: board is unsolvable\n");
 
 }
 void printCellAlreadyContainValueError(){
-	printf("Error: cell already contains a value\n");
+	printErrorMessage("Error: cell already contains a value\n");
 }
 
 void printBoardIsUnsolvable(){
-	printf("Error: board is unsolvable\n");
+	printErrorMessage("Error: board is unsolvable\n");
 }
 
 void printHint(int Z){
-	printf("Hint: set cell to %d\n", Z);
+	printMessage("Hint: set cell to %d\n", Z);
 }
 
 void printBoardIsNotEmptyError(){
-	printf("Error: board is not empty\n");
+	printErrorMessage("Error: board is not empty\n");
 }
 
 void printPuzzleGeneratorFailedError(){
-	printf("Error: puzzle generator failed\n");
+	printErrorMessage("Error: puzzle generator failed\n");
 }
 
 void printExiting(){
-	printf("Exiting...\n");
+	printMessage("Exiting...\n");
 }
 
 void printGurobiError(){
-	printf("Gurobi optimization Failed\n");
+	printErrorMessage("Gurobi optimization Failed\n");
 }
 
 void printUndoRedoMove(int x, int y, int z, int oldZ, int isUndo){
@@ -135,74 +220,199 @@ void printUndoRedoMove(int x, int y, int z, int oldZ, int isUndo){
 	}
 
 	if(z == 0 && oldZ == 0) {
-		printf("%s %d,%d: from %s to %s\n", command, y+1, x+1,EMPTY_CELL, EMPTY_CELL);
+		printMessage("%s %d,%d: from %s to %s\n", command, y+1, x+1,EMPTY_CELL, EMPTY_CELL);
 	}
 	else if(z == 0) {
-		printf("%s %d,%d: from %s to %d\n", command, y+1, x+1,EMPTY_CELL, abs(oldZ));
+		printMessage("%s %d,%d: from %s to %d\n", command, y+1, x+1,EMPTY_CELL, abs(oldZ));
 	}
 	else if(oldZ == 0) {
-		printf("%s %d,%d: from %d to %s\n", command, y+1, x+1,abs(z), EMPTY_CELL);
+		printMessage("%s %d,%d: from %d to %s\n", command, y+1, x+1,abs(z), EMPTY_CELL);
 	}
 	else {
-		printf("%s %d,%d: from %d to %d\n", command, y+1, x+1,abs(z), abs(oldZ));
+		printMessage("%s %d,%d: from %d to %d\n", command, y+1, x+1,abs(z), abs(oldZ));
 	}
 }
 
 void printNoMovesToUndoError(){
-	printf("Error: no moves to undo\n");
+	printErrorMessage("Error: no moves to undo\n");
 }
 
 void printNoMovesToRedoError(){
-	printf("Error: no moves to redo\n");
+	printErrorMessage("Error: no moves to redo\n");
 }
 
 void printResetMessage(){
-	printf("Board reset\n");
+	printMessage("Board reset\n");
 }
 
 void printCellSetTo(int i, int j, int val){
-	printf("Cell <%d,%d> set to %d\n", j+1, i+1, val);
+	printMessage("Cell <%d,%d> set to %d\n", j+1, i+1, val);
 }
 
 void printNumOfBoardSolutions(int numSolutions){
-	printf("Number of solutions: %d\n", numSolutions);
+	printMessage("Number of solutions: %d\n", numSolutions);
 }
 
 void printOnlyOneSolution(){
-	printf("This is a good board!\n");
+	printMessage("This is a good board!\n");
 }
 
 void printMoreThanOneSolution(){
-	printf("The puzzle has more than 1 solution, try to edit it further\n");
+	printMessage("The puzzle has more than 1 solution, try to edit it further\n");
+}
+
+void printJournalStarted(char * filePath){
+	printMessage("Journal: %s\n", filePath);
+}
+
+void printJournalStopped(){
+	printMessage("Journal stopped\n");
+}
+
+void printJournalFileError(){
+	printErrorMessage("Error: journal file cannot be opened\n");
+}
+
+void printJournalWriteError(){
+	printErrorMessage("Error: journal file cannot be written, journal stopped\n");
+}
+
+void printJournalRecovered(int numOfRecords){
+	printMessage("Recovered %d journal records\n", numOfRecords);
 }
 
+void printTtyRenderUnavailableError(){
+	printErrorMessage("Error: tty rendering is only available when the output is a terminal\n");
+}
 
-/* A utility function to swap to integers */
-void swap (int *a, int *b)
-{
-    int temp = *a;
-    *a = *b;
-    *b = temp;
+void printUsage(char * programName){
+	printErrorMessage("Usage: %s [-q] [-j] [-n] [--seed S] [-p N] [-g FILE] [-m N] [-f FILE | -s SOCKET [-w N] | -c SOCKET]\n"
+			"  -q         quiet - no prompts and no automatic board prints\n"
+			"  -j         protocol mode - a JSON line reply for every command\n"
+			"  -n         don't solve the board speculatively in the background after every change\n"
+			"  --seed S   seed the random generator of generate with S (reproducible puzzles)\n"
+			"  -p N       keep N pre-generated puzzles for each recent generate request\n",
+			programName);
+	/* printed in two parts: ISO C90 limits the length of a string literal */
+	printErrorMessage(
+			"  -g FILE    keep the statistics that generate auto learns from in FILE\n"
+			"  -m N       keep at most N moves in the undo-redo log (the oldest moves are dropped)\n"
+			"  -f FILE    read the commands from FILE instead of the standard input\n"
+			"  -s SOCKET  serve a game session for every connection to the Unix socket SOCKET\n"
+			"  -w N       number of solver workers shared by the server sessions (default %d)\n"
+			"  -c SOCKET  connect to the server on SOCKET and play through it\n",
+			DEFAULT_NUM_OF_SOLVER_WORKERS);
 }
 
-void randomize (int * arr, int n )
-{
-	int i;
-	int j;
-    srand ( time(NULL) );
+void printServerSocketError(char * socketPath){
+	printErrorMessage("Error: cannot listen on socket %s\n", socketPath);
+}
 
-    /* Start from the last element and swap one by one. We don't
-    need to run for the first element so i > 0 */
-    for (i = n-1; i > 0; i--)
-    {
-        /* Pick a random index from 0 to i */
-        j = rand() % (i+1);
+void printServerConnectError(char * socketPath){
+	printErrorMessage("Error: cannot connect to socket %s\n", socketPath);
+}
 
-        /* Swap arr[i] with the element at random index */
-        swap(&arr[i], &arr[j]);
-    }
+void printServerStarted(char * socketPath, int numOfWorkers){
+	printMessage("Listening on %s with %d solver workers\n", socketPath, numOfWorkers);
 }
 
+void printCommandsFileError(char * filePath){
+	printErrorMessage("Error: commands file %s cannot be opened\n", filePath);
+}
+
+void printViewSummary(int firstRow, int lastRow, int firstCol, int lastCol, int N, int filled, int errors){
+	printMessage("Rows %d-%d, columns %d-%d of %dx%d | filled: %d/%d, errors: %d\n",
+			firstRow, lastRow, firstCol, lastCol, N, N, filled, N*N, errors);
+}
+
+void printJobStarted(int id, char * commandName){
+	printMessage("[%d] %s started in the background\n", id, commandName);
+}
+
+void printJobState(int id, char * state, char * commandName, int isStale){
+	printMessage("[%d] %s %s%s\n", id, state, commandName, isStale == 1 ? " (board changed)" : "");
+}
+
+void printJobDone(int id, char * commandName, int isStale){
+	if (isStale == 1){
+		printMessage("[%d] Done %s (stale: the board changed since the job started)\n", id, commandName);
+	}
+	else {
+		printMessage("[%d] Done %s\n", id, commandName);
+	}
+}
+
+void printJobCanceled(int id, char * commandName){
+	printMessage("[%d] Canceled %s\n", id, commandName);
+}
+
+void printNoBackgroundJobs(){
+	printMessage("No background jobs\n");
+}
+
+void printNoSuchJobError(int id){
+	printErrorMessage("Error: there is no background job %d\n", id);
+}
+
+void printBackgroundJobsUnavailableError(){
+	printErrorMessage("Error: background jobs cannot be started\n");
+}
+
+void printBatchProgress(int numOfGenerated, int count, double seconds){
+	printMessage("Generated %d/%d puzzles (%.0f puzzles/sec)\n", numOfGenerated, count,
+			seconds > 0 ? numOfGenerated / seconds : 0.0);
+}
+
+void printBatchGenerated(int count, char * filePath, double seconds){
+	printMessage("Generated %d puzzles to %s in %.2f seconds (%.0f puzzles/sec)\n", count, filePath, seconds,
+			seconds > 0 ? count / seconds : 0.0);
+}
+
+void printTimeLimitReachedError(long timeLimit, double seconds){
+	printErrorMessage("Error: the time limit of %ld ms was reached (%.3f seconds)\n", timeLimit, seconds);
+}
+
+void printGenerateTimeLimitReachedError(int numOfAttempts, double seconds){
+	printErrorMessage("Error: puzzle generator reached the time limit after %d attempts (%.3f seconds)\n",
+			numOfAttempts, seconds);
+}
+
+void printBatchTimeLimitReachedError(int numOfGenerated, int count, double seconds){
+	printErrorMessage("Error: generate_batch reached the time limit after %d of %d puzzles (%.3f seconds)\n",
+			numOfGenerated, count, seconds);
+}
+
+void printGenerateAutoSeedCount(int x){
+	printMessage("Generating with X = %d\n", x);
+}
+
+void printGenerateStatsSaveError(char * filePath){
+	printErrorMessage("Error: the generate statistics could not be saved to %s\n", filePath);
+}
+
+void printPuzzleGenerated(int numOfAttempts, double seconds){
+	printMessage("Puzzle generated in %d attempts (%.3f seconds)\n", numOfAttempts, seconds);
+}
+
+void printLogicTechniqueStats(char * technique, int numOfFilledCells, long numOfEliminatedCandidates, double seconds){
+	printMessage("%-17s: %d cells filled, %ld candidates eliminated (%.6f seconds)\n", technique,
+			numOfFilledCells, numOfEliminatedCandidates, seconds);
+}
+
+void printLogicSolveSummary(int numOfFilledCells, int numOfEmptyCells){
+	if (numOfEmptyCells == 0){
+		printMessage("Logic solve filled %d cells and solved the board\n", numOfFilledCells);
+	}
+	else{
+		printMessage("Logic solve filled %d cells and got stuck with %d empty cells\n", numOfFilledCells, numOfEmptyCells);
+	}
+}
+
+void printLogicSolveContradictionError(){
+	printErrorMessage("Error: logic solve found a contradiction, the board is unsolvable\n");
+}
+
+
 /*
  * gets a pointer to a File
  * and read line on unknown length from the file
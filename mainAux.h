@@ -3,10 +3,13 @@
 *
 * DESCRIPTION :
 *       Auxiliary functions for the entire sudoku game project - print user messages, print error messgaes,
-*       get line from input and randomize an array. File main goal is to allow easy dynamic changes in messages printing.
+*       and get line from input. File main goal is to allow easy dynamic changes in messages printing.
+*       Error messages are counted, so the program exit status can tell whether any command failed.
+*       All messages are printed through the output context of the calling thread (see OutputContext below):
+*       to the context output, unless another messages stream was set (protocol mode).
+*       Threads that didn't set an output context share a default one, that prints to stdout.
 *
 * PUBLIC FUNCTIONS :
-*       void SeparatorRow(int N , int m)
 *       void printStartSudokuString()
 *       void printEnterCommand()
 *       void printInvalidCommandError()
@@ -42,12 +45,60 @@
 *       void printNumOfBoardSolutions(int numSolutions)
 *       void printOnlyOneSolution()
 *       void printMoreThanOneSolution()
+*       void printJournalStarted(char * filePath)
+*       void printJournalStopped()
+*       void printJournalFileError()
+*       void printJournalWriteError()
+*       void printJournalRecovered(int numOfRecords)
+*       void printTtyRenderUnavailableError()
+*       void printUsage(char * programName)
+*       void printCommandsFileError(char * filePath)
+*       void printServerSocketError(char * socketPath)
+*       void printServerConnectError(char * socketPath)
+*       void printServerStarted(char * socketPath, int numOfWorkers)
+*       void printViewSummary(int firstRow, int lastRow, int firstCol, int lastCol, int N, int filled, int errors)
+*       void printJobStarted(int id, char * commandName)
+*       void printJobState(int id, char * state, char * commandName, int isStale)
+*       void printJobDone(int id, char * commandName, int isStale)
+*       void printJobCanceled(int id, char * commandName)
+*       void printNoBackgroundJobs()
+*       void printNoSuchJobError(int id)
+*       void printBackgroundJobsUnavailableError()
+*       void printBatchProgress(int numOfGenerated, int count, double seconds)
+*       void printBatchGenerated(int count, char * filePath, double seconds)
+*       void printTimeLimitReachedError(long timeLimit, double seconds)
+*       void printGenerateTimeLimitReachedError(int numOfAttempts, double seconds)
+*       void printBatchTimeLimitReachedError(int numOfGenerated, int count, double seconds)
+*       void printPuzzleGenerated(int numOfAttempts, double seconds)
+*       void printGenerateAutoSeedCount(int x)
+*       void printGenerateStatsSaveError(char * filePath)
+*       void printLogicTechniqueStats(char * technique, int numOfFilledCells, long numOfEliminatedCandidates, double seconds)
+*       void printLogicSolveSummary(int numOfFilledCells, int numOfEmptyCells)
+*       void printLogicSolveContradictionError()
 *
-*       void randomize ( int * arr, int n )
+*       void initOutputContext(OutputContext * context, FILE * output)
+*       void setOutputContext(OutputContext * context)
+*       OutputContext * getOutputContext()
+*       FILE * getOutput()
+*       void setMessagesOutput(FILE * output)
+*       int getNumOfPrintedErrors()
+
 *       char *getLine(FILE * f)
 *
 ************************************/
 
+/*
+ * OutputContext is where a thread prints to:
+ * 1. output - the output stream (NULL for stdout) - messages, boards and protocol replies
+ * 2. messages - the stream messages are printed to instead of output (NULL for output)
+ * 3. numOfPrintedErrors - number of error messages printed so far in this context
+ */
+typedef struct OutputContext{
+	FILE * output;
+	FILE * messages;
+	int numOfPrintedErrors;
+}OutputContext;
+
 /* DELIMITER:
  * board files and command lines can contain any type of space between args */
 #define DELIMITER " \t\r\n"
@@ -63,9 +114,6 @@
 #define EMPTY_CELL "_"
 
 
-/* prints a series of 4N+m+1 dashes as the separator row */
-void SeparatorRow(int N , int m);
-
 /*
  * print opening game String
  */
@@ -249,11 +297,189 @@ void printOnlyOneSolution();
 void printMoreThanOneSolution();
 
 /*
- * generate a random permutation of arr[]
- * n is the length of the arr
- * using  srand ( time(NULL) ) for ramdomization
+ * print message to the user when the session journal is written to a file:
+ * "Journal: filePath\n", where filePath is the exact filename provided by the user
+ */
+void printJournalStarted(char * filePath);
+
+/*
+ * print message to the user when journaling is turned off
+ */
+void printJournalStopped();
+
+/*
+ * print message to user in case the journal file cannot be opened or created
+ */
+void printJournalFileError();
+
+/*
+ * print message to user in case the journal file cannot be written
+ */
+void printJournalWriteError();
+
+/*
+ * print the number of journal records that were replayed by recover
+ */
+void printJournalRecovered(int numOfRecords);
+
+/*
+ * print message to user in case tty mode is requested but the output isn't a terminal
+ */
+void printTtyRenderUnavailableError();
+
+/*
+ * print the command line usage of the program
+ */
+void printUsage(char * programName);
+
+/*
+ * print message to user in case the commands file (-f option) cannot be opened
+ */
+void printCommandsFileError(char * filePath);
+
+/*
+ * print message to user in case the server socket (-s option) cannot be created
+ */
+void printServerSocketError(char * socketPath);
+
+/*
+ * print message to user in case the client (-c option) cannot connect to the server socket
+ */
+void printServerConnectError(char * socketPath);
+
+/*
+ * print the server socket and its number of solver workers when the server starts
+ */
+void printServerStarted(char * socketPath, int numOfWorkers);
+
+/*
+ * print the summary line of a board printed through a view:
+ * the printed rows and columns (1-based, inclusive), the board size N,
+ * the number of filled cells and the number of erroneous cells in the whole board
+ */
+void printViewSummary(int firstRow, int lastRow, int firstCol, int lastCol, int N, int filled, int errors);
+
+/*
+ * print the number of a background job that was started, and its command
+ */
+void printJobStarted(int id, char * commandName);
+
+/*
+ * print a background job line of the jobs command: number, state and command,
+ * and whether the board changed since the job started
+ */
+void printJobState(int id, char * state, char * commandName, int isStale);
+
+/*
+ * print the line before the result of a background job, marked as stale if the board changed since the job started
+ */
+void printJobDone(int id, char * commandName, int isStale);
+
+/*
+ * print message to user when a background job is canceled
+ */
+void printJobCanceled(int id, char * commandName);
+
+/*
+ * print message to user when there are no background jobs to list
+ */
+void printNoBackgroundJobs();
+
+/*
+ * print message to user in case there is no background job with the given number
+ */
+void printNoSuchJobError(int id);
+
+/*
+ * print message to user in case the background workers cannot be started
+ */
+void printBackgroundJobsUnavailableError();
+
+/*
+ * print the progress of generate_batch: numOfGenerated of count puzzles were written in the given seconds
+ */
+void printBatchProgress(int numOfGenerated, int count, double seconds);
+
+/*
+ * print message to user after generate_batch wrote count puzzles to filePath in the given seconds
+ */
+void printBatchGenerated(int count, char * filePath, double seconds);
+
+/*
+ * print message to user in case the solver was stopped by the time limit (timeLimit milliseconds) after the given seconds
+ */
+void printTimeLimitReachedError(long timeLimit, double seconds);
+
+/*
+ * print message to user in case generate was stopped by the time limit after numOfAttempts attempts and the given seconds
+ */
+void printGenerateTimeLimitReachedError(int numOfAttempts, double seconds);
+
+/*
+ * print message to user in case generate_batch was stopped by the time limit
+ * after numOfGenerated of count puzzles and the given seconds
+ */
+void printBatchTimeLimitReachedError(int numOfGenerated, int count, double seconds);
+
+/*
+ * print message to user after generate found a puzzle in numOfAttempts attempts and the given seconds
+ */
+void printPuzzleGenerated(int numOfAttempts, double seconds);
+
+/*
+ * print the number of cells (X) that generate auto chose to fill
+ */
+void printGenerateAutoSeedCount(int x);
+
+/*
+ * print message to user in case the generate statistics file cannot be replaced
+ */
+void printGenerateStatsSaveError(char * filePath);
+
+/*
+ * print message to user with the cells a logic technique filled, the candidates it removed and the seconds spent in it
+ */
+void printLogicTechniqueStats(char * technique, int numOfFilledCells, long numOfEliminatedCandidates, double seconds);
+
+/*
+ * print message to user after logic_solve filled numOfFilledCells cells and numOfEmptyCells cells are left empty
+ */
+void printLogicSolveSummary(int numOfFilledCells, int numOfEmptyCells);
+
+/*
+ * print message to user in case logic_solve found a contradiction on the board
+ */
+void printLogicSolveContradictionError();
+
+/*
+ * initialize an output context that prints to output (NULL for stdout)
+ */
+void initOutputContext(OutputContext * context, FILE * output);
+
+/*
+ * sets the output context of the calling thread (NULL for the default output context)
+ */
+void setOutputContext(OutputContext * context);
+
+/*
+ * returns the output context of the calling thread
+ */
+OutputContext * getOutputContext();
+
+/*
+ * returns the output stream of the calling thread output context
+ */
+FILE * getOutput();
+
+/*
+ * print all the following messages of the calling thread output context to output (NULL for the context output)
+ */
+void setMessagesOutput(FILE * output);
+
+/*
+ * return the number of error messages printed so far in the calling thread output context
  */
-void randomize ( int * arr, int n );
+int getNumOfPrintedErrors();
 
 /*
  * read line of unknown length from a file